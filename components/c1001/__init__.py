@@ -1,8 +1,10 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import uart
+from esphome.components import sensor, uart
 from esphome.const import (
+    CONF_FROM,
     CONF_ID,
+    CONF_TO,
     CONF_UPDATE_INTERVAL,
     UNIT_EMPTY,
     UNIT_BEATS_PER_MINUTE,
@@ -10,11 +12,12 @@ from esphome.const import (
 )
 
 DEPENDENCIES = ["uart"]
-AUTO_LOAD = ["sensor", "binary_sensor"]
+AUTO_LOAD = ["sensor", "binary_sensor", "text_sensor"]
 MULTI_CONF = True
 
 c1001_ns = cg.esphome_ns.namespace("c1001")
 C1001Component = c1001_ns.class_("C1001Component", cg.PollingComponent, uart.UARTDevice)
+C1001MetricId = c1001_ns.enum("C1001MetricId")
 
 CONF_C1001_ID = "c1001_id"
 CONF_RESPIRATION_RATE = "respiration_rate"
@@ -22,12 +25,137 @@ CONF_HEART_RATE = "heart_rate"
 CONF_PRESENCE = "presence"
 CONF_MOVEMENT = "movement"
 CONF_PERSON_DETECTED = "person_detected"
+CONF_PUSH_REPORTS = "push_reports"
+CONF_COMPOSITE_FIRST = "composite_first"
+CONF_ADAPTIVE_POLLING = "adaptive_polling"
+CONF_VACANT_INTERVAL = "vacant_interval"
+CONF_VACANT_AFTER = "vacant_after"
+CONF_MAX_IN_FLIGHT = "max_in_flight"
+CONF_POLL_INTERVAL = "poll_interval"
+CONF_UART_TASK = "uart_task"
+CONF_CAPTURE_SIZE = "capture_size"
+CONF_NIGHT_STORE_SIZE = "night_store_size"
+CONF_SLEEP_SESSION = "sleep_session"
+CONF_END_AFTER = "end_after"
+CONF_MIN_DURATION = "min_duration"
+# Two 256-byte blocks: one being written, one complete
+MIN_NIGHT_STORE_SIZE = 512
+
+# Per-sensor polling rate; sensors without it follow the component's update_interval
+POLL_INTERVAL_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_POLL_INTERVAL): cv.positive_time_period_milliseconds,
+    }
+)
+
+
+# Change-only publishing; setting either key turns it on for the sensor
+CONF_DEADBAND = "deadband"
+CONF_HEARTBEAT = "heartbeat"
+DEFAULT_HEARTBEAT_MS = 15 * 60 * 1000
+PUBLISH_POLICY_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_DEADBAND): cv.float_range(min=0),
+        cv.Optional(CONF_HEARTBEAT): cv.positive_time_period_milliseconds,
+    }
+)
+
+
+def register_polled_metric(paren, metric, config):
+    """Add the register behind a configured sensor to the poll plan."""
+    interval = config.get(CONF_POLL_INTERVAL)
+    cg.add(paren.add_polled_metric(metric, interval.total_milliseconds if interval is not None else 0))
+
+
+def register_sleep_session(paren):
+    """The session tracker follows in-bed and sleep state, so both need polling."""
+    register_polled_metric(paren, C1001MetricId.METRIC_IN_BED, {})
+    register_polled_metric(paren, C1001MetricId.METRIC_SLEEP_STATE, {})
+
+
+def register_publish_policy(paren, sens, config):
+    """Publish the sensor only on a change beyond its deadband, or on its heartbeat."""
+    if CONF_DEADBAND not in config and CONF_HEARTBEAT not in config:
+        return
+    heartbeat = config.get(CONF_HEARTBEAT)
+    heartbeat_ms = heartbeat.total_milliseconds if heartbeat is not None else DEFAULT_HEARTBEAT_MS
+    cg.add(paren.set_publish_policy(sens, config.get(CONF_DEADBAND, 0.0), heartbeat_ms))
+
+# Per-device raw -> BPM calibration. Each metric takes a list of "raw -> bpm" points; the
+# 256-entry table is interpolated between them (and held flat past the ends) at build time.
+CONF_CALIBRATION = "calibration"
+CONF_RESPIRATION_TABLE_ID = "respiration_table_id"
+CONF_HEART_RATE_TABLE_ID = "heart_rate_table_id"
+CALIBRATION_POINTS = cv.All(
+    cv.ensure_list(sensor.validate_datapoint),
+    cv.Length(min=1),
+)
+
+
+def calibration_table(points):
+    """Expand calibration points into one value per raw byte."""
+    points = sorted((p[CONF_FROM], p[CONF_TO]) for p in points)
+    table = []
+    for raw in range(256):
+        if raw <= points[0][0]:
+            table.append(points[0][1])
+        elif raw >= points[-1][0]:
+            table.append(points[-1][1])
+        else:
+            for (x0, y0), (x1, y1) in zip(points, points[1:]):
+                if x0 <= raw <= x1:
+                    table.append(y0 if x1 == x0 else y0 + (y1 - y0) * (raw - x0) / (x1 - x0))
+                    break
+    return table
+
+
+def validate_uart_task(value):
+    """The UART task needs FreeRTOS, so it can only be enabled on ESP32."""
+    value = cv.boolean(value)
+    if value:
+        cv.only_on_esp32(value)
+    return value
+
+
+def validate_night_store_size(value):
+    """0 turns the night store off; anything else needs room for two blocks."""
+    value = cv.int_range(min=0, max=131072)(value)
+    if 0 < value < MIN_NIGHT_STORE_SIZE:
+        raise cv.Invalid(f"night_store_size must be 0 or at least {MIN_NIGHT_STORE_SIZE} bytes")
+    return value
+
 
 CONFIG_SCHEMA = (
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(C1001Component),
             cv.Optional(CONF_UPDATE_INTERVAL, default="5s"): cv.update_interval,
+            cv.Optional(CONF_PUSH_REPORTS, default=True): cv.boolean,
+            cv.Optional(CONF_COMPOSITE_FIRST, default=False): cv.boolean,
+            cv.Optional(CONF_ADAPTIVE_POLLING): cv.Schema(
+                {
+                    cv.Optional(CONF_VACANT_INTERVAL, default="10s"): cv.positive_time_period_milliseconds,
+                    cv.Optional(CONF_VACANT_AFTER, default="2min"): cv.positive_time_period_milliseconds,
+                }
+            ),
+            cv.Optional(CONF_MAX_IN_FLIGHT, default=4): cv.int_range(min=1, max=8),
+            cv.Optional(CONF_UART_TASK, default=False): validate_uart_task,
+            cv.Optional(CONF_CAPTURE_SIZE, default=512): cv.int_range(min=0, max=32768),
+            cv.Optional(CONF_NIGHT_STORE_SIZE, default=0): validate_night_store_size,
+            cv.Optional(CONF_SLEEP_SESSION, default={}): cv.Schema(
+                {
+                    cv.Optional(CONF_END_AFTER, default="15min"): cv.positive_time_period_milliseconds,
+                    cv.Optional(CONF_MIN_DURATION, default="30min"): cv.positive_time_period_milliseconds,
+                }
+            ),
+            cv.Optional(CONF_CALIBRATION): cv.Schema(
+                {
+                    cv.GenerateID(CONF_RESPIRATION_TABLE_ID): cv.declare_id(cg.float_),
+                    cv.GenerateID(CONF_HEART_RATE_TABLE_ID): cv.declare_id(cg.float_),
+                    cv.Optional(CONF_RESPIRATION_RATE): CALIBRATION_POINTS,
+                    cv.Optional(CONF_HEART_RATE): CALIBRATION_POINTS,
+                }
+            ),
         }
     )
     .extend(cv.polling_component_schema("5s"))
@@ -38,4 +166,39 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     await uart.register_uart_device(var, config)
+    cg.add(var.set_push_reports(config[CONF_PUSH_REPORTS]))
+    cg.add(var.set_composite_first(config[CONF_COMPOSITE_FIRST]))
+    if CONF_ADAPTIVE_POLLING in config:
+        adaptive = config[CONF_ADAPTIVE_POLLING]
+        cg.add(
+            var.set_adaptive_polling(
+                adaptive[CONF_VACANT_INTERVAL].total_milliseconds,
+                adaptive[CONF_VACANT_AFTER].total_milliseconds,
+            )
+        )
+    cg.add(var.set_max_in_flight(config[CONF_MAX_IN_FLIGHT]))
+    cg.add(var.set_uart_task(config[CONF_UART_TASK]))
+    cg.add(var.set_capture_size(config[CONF_CAPTURE_SIZE]))
+    cg.add(var.set_night_store_size(config[CONF_NIGHT_STORE_SIZE]))
+    session = config[CONF_SLEEP_SESSION]
+    cg.add(
+        var.set_sleep_session(
+            session[CONF_END_AFTER].total_milliseconds,
+            session[CONF_MIN_DURATION].total_milliseconds,
+        )
+    )
+    if CONF_CALIBRATION in config:
+        calibration = config[CONF_CALIBRATION]
+        if CONF_RESPIRATION_RATE in calibration:
+            table = cg.static_const_array(
+                calibration[CONF_RESPIRATION_TABLE_ID],
+                cg.ArrayInitializer(*calibration_table(calibration[CONF_RESPIRATION_RATE])),
+            )
+            cg.add(var.set_respiration_calibration(table))
+        if CONF_HEART_RATE in calibration:
+            table = cg.static_const_array(
+                calibration[CONF_HEART_RATE_TABLE_ID],
+                cg.ArrayInitializer(*calibration_table(calibration[CONF_HEART_RATE])),
+            )
+            cg.add(var.set_heart_rate_calibration(table))
     
@@ -1,11 +1,13 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import binary_sensor
-from . import c1001_ns, C1001Component, CONF_PERSON_DETECTED, CONF_C1001_ID
+from . import c1001_ns, C1001Component, CONF_PERSON_DETECTED, CONF_C1001_ID, C1001MetricId, POLL_INTERVAL_SCHEMA, register_polled_metric
 
 # Sleep binary sensors
 CONF_ABNORMAL_STRUGGLE = "abnormal_struggle"
 CONF_SLEEP_DISTURBANCE = "sleep_disturbance"
+# Polled "nobody" samples in a row before person_detected clears
+CONF_CLEAR_SAMPLES = "clear_samples"
 
 # CONF_C1001_ID already imported from __init__.py
 
@@ -14,15 +16,19 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Required(CONF_C1001_ID): cv.use_id(C1001Component),
         cv.Optional(CONF_PERSON_DETECTED): binary_sensor.binary_sensor_schema(
             device_class="occupancy",
+        ).extend(POLL_INTERVAL_SCHEMA).extend(
+            {
+                cv.Optional(CONF_CLEAR_SAMPLES, default=2): cv.int_range(min=1, max=10),
+            }
         ),
         cv.Optional(CONF_ABNORMAL_STRUGGLE): binary_sensor.binary_sensor_schema(
             device_class="problem",
             icon="mdi:exclamation",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA),
         cv.Optional(CONF_SLEEP_DISTURBANCE): binary_sensor.binary_sensor_schema(
             device_class="problem",
             icon="mdi:sleep-off",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA),
     }
 )
 
@@ -34,13 +40,17 @@ async def to_code(config):
         conf = config[CONF_PERSON_DETECTED]
         sens = await binary_sensor.new_binary_sensor(conf)
         cg.add(paren.set_person_detected_binary_sensor(sens))
+        cg.add(paren.set_presence_clear_samples(conf[CONF_CLEAR_SAMPLES]))
+        register_polled_metric(paren, C1001MetricId.METRIC_PRESENCE, conf)
         
     if CONF_ABNORMAL_STRUGGLE in config:
         conf = config[CONF_ABNORMAL_STRUGGLE]
         sens = await binary_sensor.new_binary_sensor(conf)
         cg.add(paren.set_abnormal_struggle_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_ABNORMAL_STRUGGLE, conf)
         
     if CONF_SLEEP_DISTURBANCE in config:
         conf = config[CONF_SLEEP_DISTURBANCE]
         sens = await binary_sensor.new_binary_sensor(conf)
-        cg.add(paren.set_sleep_disturbance_sensor(sens))
\ No newline at end of file
+        cg.add(paren.set_sleep_disturbance_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_SLEEP_DISTURBANCE, conf)
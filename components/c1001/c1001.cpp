@@ -3,6 +3,9 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/application.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace esphome {
 namespace c1001 {
 
@@ -11,8 +14,39 @@ static const char *const TAG = "c1001";
 static const uint8_t MAX_CONSECUTIVE_ERRORS = 20;
 // Timeout in milliseconds before considering the sensor dead
 static const uint32_t SENSOR_TIMEOUT_MS = 120000;
-// ESP32 may still need minimal delays at critical points
-static const uint32_t MIN_OP_DELAY_MS = 5;
+// How long a request may stay unanswered before loop() gives up on it
+static const uint32_t RESPONSE_TIMEOUT_MS = 2000;
+// Wait after the init reset before the first polls go out
+static const uint32_t RESET_SETTLE_MS = 1000;
+// Bytes loop() parses per call; covers a full UART RX buffer (256 bytes by default)
+static const uint16_t MAX_RX_BYTES_PER_LOOP = 256;
+#ifdef USE_ESP32
+static const uint32_t UART_TASK_STACK_SIZE = 4096;
+// Above the ESPHome loop task (priority 1), so the link is serviced even while it's busy
+static const UBaseType_t UART_TASK_PRIORITY = 5;
+#endif
+// Repeats of a warning within this window are counted instead of logged
+static const uint32_t WARNING_INTERVAL_MS = 60000;
+// Upper bounds of the round-trip histogram buckets in ms; the last bucket is open-ended
+static const uint16_t LATENCY_BUCKET_MS[C1001_LATENCY_BUCKETS - 1] = {2, 5, 10, 20, 50, 100, 500};
+// Iterations per self-benchmark case - keeps a full run to a few milliseconds
+static const uint16_t BENCHMARK_ITERATIONS = 2000;
+// Raw bytes per capture or night store dump log line
+static const uint8_t DUMP_LINE_BYTES = 32;
+// Hypnogram text buffer; Home Assistant keeps at most 255 characters of a state
+static const size_t SESSION_HYPNOGRAM_SIZE = 256;
+// Default presence poll interval, so occupancy edges arrive within about a second
+static const uint32_t PRESENCE_POLL_MS = 1000;
+
+// The default calibration tables, built from the curves at compile time
+constexpr C1001CalibrationTable C1001_DEFAULT_RESPIRATION(c1001_default_respiration);
+constexpr C1001CalibrationTable C1001_DEFAULT_HEART_RATE(c1001_default_heart_rate);
+static_assert(C1001_DEFAULT_RESPIRATION.bpm[0] == 10.0f && C1001_DEFAULT_RESPIRATION.bpm[18] == 18.0f &&
+                  C1001_DEFAULT_RESPIRATION.bpm[100] == 10.0f + (100.0f / 255.0f) * 15.0f,
+              "respiration table follows the default curve");
+static_assert(C1001_DEFAULT_HEART_RATE.bpm[0] == 60.0f && C1001_DEFAULT_HEART_RATE.bpm[40] == 50.0f &&
+                  C1001_DEFAULT_HEART_RATE.bpm[72] == 72.0f,
+              "heart rate table follows the default curve");
 
 // Create enum to track initialization state
 enum C1001InitState {
@@ -28,9 +62,9 @@ enum C1001InitState {
 void C1001Component::setup() {
   ESP_LOGCONFIG(TAG, "Setting up C1001 component with direct UART communication...");
   
-  // Ensure UART is flushed before starting
+  // Ensure UART is flushed before starting. No settling delay: the parser resyncs on
+  // whatever arrives, and blocking here would hold up every other radar on the node.
   this->flush();
-  delay(100);
   
   // We're using direct UART communication, so we don't need the stream adapter
   // and sensor objects anymore - we've implemented direct commands
@@ -38,6 +72,37 @@ void C1001Component::setup() {
   // Just mark that we're ready to start initialization
   this->init_state_ = INIT_CREATED;
   
+  // Metrics configured without their own poll_interval follow the component's update
+  // interval; slow sleep metrics get a third of that rate, as before. Presence is
+  // polled at least once a second. An explicit interval on a shared register only
+  // wins if it is faster.
+  for (uint8_t metric = 0; metric < C1001_METRIC_COUNT; metric++) {
+    if (!this->poll_default_[metric]) {
+      continue;
+    }
+    uint32_t interval = this->get_update_interval();
+    if (METRICS[metric].poll_class == POLL_CLASS_PRESENCE) {
+      interval = std::min(interval, PRESENCE_POLL_MS);
+    } else if (METRICS[metric].poll_class != POLL_CLASS_VITAL) {
+      interval *= 3;
+    }
+    if (this->poll_interval_[metric] == 0 || interval < this->poll_interval_[metric]) {
+      this->poll_interval_[metric] = interval;
+    }
+  }
+  if (this->composite_first_) {
+    this->fold_into_composite_();
+  }
+  
+  if (this->capture_size_ > 0) {
+    this->capture_buffer_.reset(new uint8_t[this->capture_size_]);
+    this->capture_.init(this->capture_buffer_.get(), this->capture_size_);
+  }
+  if (this->night_store_size_ > 0) {
+    this->night_store_buffer_.reset(new uint8_t[this->night_store_size_]);
+    this->night_store_.init(this->night_store_buffer_.get(), this->night_store_size_);
+  }
+  
   // Initialize error recovery counters
   this->consecutive_errors_ = 0;
   this->last_successful_read_ = millis();
@@ -45,17 +110,42 @@ void C1001Component::setup() {
   // Reset Arduino core WDT just to be safe
   delay(1);
   
+#ifdef USE_ESP32
+  if (this->uart_task_) {
+    // Pin the link to the core the ESPHome loop isn't running on
+    BaseType_t core = portNUM_PROCESSORS > 1 ? 1 - xPortGetCoreID() : 0;
+    this->link_in_task_ = true;
+    if (xTaskCreatePinnedToCore(uart_task_loop_, "c1001_uart", UART_TASK_STACK_SIZE, this, UART_TASK_PRIORITY,
+                                &this->uart_task_handle_, core) != pdPASS) {
+      ESP_LOGE(TAG, "Could not start the UART task, running the link from loop()");
+      this->link_in_task_ = false;
+      this->uart_task_handle_ = nullptr;
+    }
+  }
+#endif
+  
   ESP_LOGI(TAG, "C1001 setup started - initialization will continue during update cycles");
 }
 
-void C1001Component::reset_initialization() {
+#ifdef USE_ESP32
+void C1001Component::uart_task_loop_(void *arg) {
+  auto *self = static_cast<C1001Component *>(arg);
+  for (;;) {
+    self->service_link_();
+    vTaskDelay(1);
+  }
+}
+#endif
+
+void C1001Component::reset_initialization_() {
   ESP_LOGW(TAG, "Resetting initialization process");
   this->init_state_ = INIT_CREATED;
   this->sensor_initialized_ = false;
   this->consecutive_errors_ = 0;
+  this->clear_requests_();
 }
 
-void C1001Component::on_uart_error() {
+void C1001Component::on_uart_error_() {
   ESP_LOGW(TAG, "UART Error detected");
   this->consecutive_errors_++;
   
@@ -63,7 +153,7 @@ void C1001Component::on_uart_error() {
   if (this->consecutive_errors_ >= MAX_CONSECUTIVE_ERRORS) {
     ESP_LOGE(TAG, "Too many consecutive UART errors (%d), resetting initialization", 
              this->consecutive_errors_);
-    this->reset_initialization();
+    this->reset_initialization_();
   }
 }
 
@@ -110,290 +200,788 @@ void C1001Component::on_uart_error() {
 #define CMD_GET_SLEEP_QUALITY_RATING 0x90  // Sleep quality rating (0=none, 1=good, 2=avg, 3=poor)
 #define CMD_GET_ABNORMAL_STRUGGLE  0x91  // Abnormal struggle (0=none, 1=normal, 2=abnormal)
 
-// Response parsing state machine states
-#define STATE_WAIT_START1      0
-#define STATE_WAIT_START2      1
-#define STATE_WAIT_CONFIG      2
-#define STATE_WAIT_CMD         3
-#define STATE_WAIT_LEN_H       4
-#define STATE_WAIT_LEN_L       5
-#define STATE_READ_DATA        6
-#define STATE_CHECK_SUM        7
-#define STATE_WAIT_END1        8
-#define STATE_WAIT_END2        9
+// Extra transmissions of a poll request before it counts as a failed read
+static const uint8_t MAX_REQUEST_RETRIES = 1;
+// A metric the radar reported on its own within this window is not polled
+static const uint32_t PUSH_COVERAGE_MS = 60000;
+
+// Every request the component sends, built at compile time with its checksum so the
+// frames live in flash and send_command_() only has to hand them to the UART
+static constexpr C1001Frame FRAME_GET_LED = make_c1001_request(REG_CONFIG, CMD_GET_LED);
+static constexpr C1001Frame FRAME_SET_LED_ON = make_c1001_request(REG_CONFIG, CMD_SET_LED, 0x01);
+static constexpr C1001Frame FRAME_RESET = make_c1001_request(REG_CONFIG, CMD_RESET);
+static constexpr C1001Frame FRAME_GET_WORK_MODE = make_c1001_request(REG_WORK_MODE, CMD_GET_WORK_MODE);
+static constexpr C1001Frame FRAME_SET_SLEEP_MODE = make_c1001_request(REG_WORK_MODE, CMD_SET_WORK_MODE, MODE_SLEEP);
+
+// Known-good frames captured from the DFRobot_HumanDetection library - the encoder must match byte for byte
+static constexpr uint8_t DFROBOT_GET_PRESENCE[] = {0x53, 0x59, 0x80, 0x81, 0x00, 0x01, 0x0F, 0xBD, 0x54, 0x43};
+static constexpr uint8_t DFROBOT_GET_HEART_RATE[] = {0x53, 0x59, 0x85, 0x82, 0x00, 0x01, 0x0F, 0xC3, 0x54, 0x43};
+static constexpr uint8_t DFROBOT_GET_SLEEP_COMPOSITE[] = {0x53, 0x59, 0x84, 0x8D, 0x00, 0x01, 0x0F, 0xCD, 0x54, 0x43};
+static constexpr uint8_t DFROBOT_GET_LED[] = {0x53, 0x59, 0x01, 0x83, 0x00, 0x01, 0x0F, 0x40, 0x54, 0x43};
+static constexpr uint8_t DFROBOT_GET_WORK_MODE[] = {0x53, 0x59, 0x02, 0xA8, 0x00, 0x01, 0x0F, 0x66, 0x54, 0x43};
+static constexpr uint8_t DFROBOT_SET_SLEEP_MODE[] = {0x53, 0x59, 0x02, 0xA8, 0x00, 0x01, 0x02, 0x59, 0x54, 0x43};
+static_assert(c1001_frame_equals(FRAME_GET_LED, DFROBOT_GET_LED), "LED query frame");
+static_assert(c1001_frame_equals(FRAME_GET_WORK_MODE, DFROBOT_GET_WORK_MODE), "work mode query frame");
+static_assert(c1001_frame_equals(FRAME_SET_SLEEP_MODE, DFROBOT_SET_SLEEP_MODE), "sleep mode set frame");
+
+// Payload decoders - return the value to publish, or NAN to reject the sample
+static float decode_u8(C1001FrameView payload) { return payload[0]; }
+
+// For durations, it's 16-bit (2 bytes), big-endian
+static float decode_u16(C1001FrameView payload) { return (payload[0] << 8) | payload[1]; }
+
+// Binary interpretations of decoded values
+// Only consider it "on" if it's in abnormal state (2)
+static bool struggle_is_abnormal(float struggle) { return struggle == 2; }
+// Only consider it "on" if there's a disturbance (not 3=none)
+static bool disturbance_present(float disturbance) { return disturbance != 3; }
+
+// The register map: one row per radar register the component reads. Poll requests,
+// push report routing, payload length checks and publishing are all driven from here.
+// Unsolicited reports carry the same register with the query bit (0x80) of the command cleared.
+constexpr C1001MetricDef C1001Component::METRICS[C1001_METRIC_COUNT] = {
+  // name, request, width, poll class, decoder, sensor, binary sensor, binary decoder, cache, handler,
+  // then optionally the spec range (published with a warning outside it), the plausible
+  // range (dropped outside it), the raw -> value calibration table replacing the decoder
+  // and the filter applied before publishing
+  {"presence", make_c1001_request(REG_BASIC_HUMAN, CMD_GET_PRESENCE), 1, POLL_CLASS_PRESENCE, nullptr,
+   nullptr, nullptr, nullptr, nullptr, &C1001Component::handle_presence_},
+  // Movement state (0=none, 1=slight, 2=intense)
+  {"movement", make_c1001_request(REG_BASIC_HUMAN, CMD_GET_MOVEMENT), 1, POLL_CLASS_STATUS, decode_u8,
+   &C1001Component::movement_sensor_, nullptr, nullptr, nullptr, nullptr, 0.0f, 2.0f, 0.0f, 2.0f},
+  // Official spec 10-25 BPM, still published within more generous limits
+  {"respiration", make_c1001_request(REG_BREATH, CMD_GET_BREATHING), 1, POLL_CLASS_VITAL, nullptr,
+   &C1001Component::respiration_sensor_, nullptr, nullptr, nullptr, nullptr, 10.0f, 25.0f, 8.0f, 30.0f,
+   &C1001Component::respiration_calibration_, &C1001Component::respiration_filter_},
+  // Official spec 60-100 BPM, still published within more generous limits
+  {"heart rate", make_c1001_request(REG_HEART, CMD_GET_HEART_RATE), 1, POLL_CLASS_VITAL, nullptr,
+   &C1001Component::heart_rate_sensor_, nullptr, nullptr, nullptr, nullptr, 60.0f, 100.0f, 40.0f, 120.0f,
+   &C1001Component::heart_rate_calibration_, &C1001Component::heart_rate_filter_},
+  {"in bed", make_c1001_request(REG_SLEEP, CMD_GET_IN_BED), 1, POLL_CLASS_SLEEP, decode_u8,
+   &C1001Component::in_bed_sensor_, nullptr, nullptr, &C1001Component::in_bed_, nullptr},
+  {"sleep state", make_c1001_request(REG_SLEEP, CMD_GET_SLEEP_STATE), 1, POLL_CLASS_SLEEP, decode_u8,
+   &C1001Component::sleep_state_sensor_, nullptr, nullptr, &C1001Component::sleep_state_, nullptr},
+  {"sleep quality", make_c1001_request(REG_SLEEP, CMD_GET_SLEEP_QUALITY), 1, POLL_CLASS_SLEEP, decode_u8,
+   &C1001Component::sleep_quality_sensor_, nullptr, nullptr, &C1001Component::sleep_quality_score_, nullptr},
+  {"sleep quality rating", make_c1001_request(REG_SLEEP, CMD_GET_SLEEP_QUALITY_RATING), 1, POLL_CLASS_SLEEP,
+   decode_u8, &C1001Component::sleep_quality_rating_sensor_, nullptr, nullptr,
+   &C1001Component::sleep_quality_rating_, nullptr},
+  {"abnormal struggle", make_c1001_request(REG_SLEEP, CMD_GET_ABNORMAL_STRUGGLE), 1, POLL_CLASS_SLEEP, decode_u8,
+   nullptr, &C1001Component::abnormal_struggle_sensor_, struggle_is_abnormal, nullptr, nullptr},
+  {"sleep composite", make_c1001_request(REG_SLEEP, CMD_GET_SLEEP_COMPOSITE), 8, POLL_CLASS_SLEEP, nullptr,
+   nullptr, nullptr, nullptr, nullptr, &C1001Component::handle_sleep_composite_},
+  {"awake duration", make_c1001_request(REG_SLEEP, CMD_GET_WAKE_DURATION), 2, POLL_CLASS_SLEEP, decode_u16,
+   &C1001Component::awake_duration_sensor_, nullptr, nullptr, nullptr, nullptr},
+  {"light sleep duration", make_c1001_request(REG_SLEEP, CMD_GET_LIGHT_SLEEP), 2, POLL_CLASS_SLEEP, decode_u16,
+   &C1001Component::light_sleep_duration_sensor_, nullptr, nullptr, nullptr, nullptr},
+  {"deep sleep duration", make_c1001_request(REG_SLEEP, CMD_GET_DEEP_SLEEP), 2, POLL_CLASS_SLEEP, decode_u16,
+   &C1001Component::deep_sleep_duration_sensor_, nullptr, nullptr, nullptr, nullptr},
+  {"sleep disturbance", make_c1001_request(REG_SLEEP, CMD_GET_SLEEP_DISTURBANCE), 1, POLL_CLASS_SLEEP, decode_u8,
+   nullptr, &C1001Component::sleep_disturbance_sensor_, disturbance_present, nullptr, nullptr},
+  // The statistics frame opens with the overall sleep score; only that field is used
+  {"sleep statistics", make_c1001_request(REG_SLEEP, CMD_GET_SLEEP_STATISTICS), 1, POLL_CLASS_SLEEP, decode_u8,
+   &C1001Component::sleep_score_sensor_, nullptr, nullptr, nullptr, nullptr},
+};
+
+static_assert(c1001_frame_equals(C1001Component::METRICS[METRIC_PRESENCE].request, DFROBOT_GET_PRESENCE),
+              "presence query frame");
+static_assert(c1001_frame_equals(C1001Component::METRICS[METRIC_HEART_RATE].request, DFROBOT_GET_HEART_RATE),
+              "heart rate query frame");
+static_assert(c1001_frame_equals(C1001Component::METRICS[METRIC_SLEEP_COMPOSITE].request,
+                                 DFROBOT_GET_SLEEP_COMPOSITE),
+              "sleep composite query frame");
+
+// Samples copy at most C1001_MAX_METRIC_WIDTH payload bytes
+static constexpr bool metric_widths_fit(uint8_t i = 0) {
+  return i == C1001_METRIC_COUNT ||
+         (C1001Component::METRICS[i].width <= C1001_MAX_METRIC_WIDTH && metric_widths_fit(i + 1));
+}
+static_assert(metric_widths_fit(), "register map row wider than C1001Sample::payload");
 
 // Calculate checksum - sum all bytes in buffer and take lower 8 bits
 uint8_t C1001Component::calculate_checksum(uint8_t len, uint8_t* buf) {
-  uint16_t sum = 0;
-  for (uint8_t i = 0; i < len; i++) {
-    sum += buf[i];
+  return c1001_checksum(buf, len);
+}
+
+// Send a pre-built request frame. Returns as soon as the frame is on the wire;
+// replies are matched to queued requests by loop(), see enqueue_request_().
+bool C1001Component::send_command_(const C1001Frame &frame) {
+  uint8_t cmd_len = sizeof(frame.bytes);
+  const uint8_t *cmd_buffer = frame.bytes;
+  
+  // The raw bytes go to the trace ring; they're only formatted if someone dumps it
+  this->capture_.record(millis(), true, cmd_buffer, cmd_len);
+  ESP_LOGV(TAG, "TX %02X:%02X data %02X", frame.con(), frame.cmd(), cmd_buffer[6]);
+  this->tx_bytes_ += cmd_len;
+  
+  // Send full command in one buffered write - the UART driver paces the bytes itself
+  uint32_t write_start = micros();
+  this->write_array(cmd_buffer, cmd_len);
+  uint32_t write_us = micros() - write_start;
+  if (write_us > this->tx_write_us_max_) {
+    this->tx_write_us_max_ = write_us;
+  }
+  ESP_LOGV(TAG, "Queued %d bytes in %u us (%u us on the wire)", cmd_len, write_us,
+           this->wire_time_us_(cmd_len));
+  return true;
+}
+
+// Add a request to the pipeline. A request already queued or in flight is not added
+// twice - the reply to it could not be told apart from the reply to the duplicate.
+bool C1001Component::enqueue_request_(const C1001Frame &frame, uint8_t step) {
+  C1001Request *free_slot = nullptr;
+  for (auto &request : this->requests_) {
+    if (request.frame == nullptr) {
+      if (free_slot == nullptr) {
+        free_slot = &request;
+      }
+    } else if (request.frame->con() == frame.con() && request.frame->cmd() == frame.cmd()) {
+      ESP_LOGV(TAG, "Request %02X:%02X already pending", frame.con(), frame.cmd());
+      return false;
+    }
+  }
+  
+  if (free_slot == nullptr) {
+    uint16_t suppressed;
+    if (this->warn_allowed_(this->queue_full_warning_, suppressed)) {
+      ESP_LOGW(TAG, "Command queue full, dropping request %02X:%02X [%u similar suppressed]", frame.con(),
+               frame.cmd(), suppressed);
+    }
+    return false;
+  }
+  
+  free_slot->frame = &frame;
+  free_slot->step = step;
+  free_slot->attempts = 0;
+  free_slot->in_flight = false;
+  free_slot->priority = step != C1001_INIT_STEP && METRICS[step].poll_class == POLL_CLASS_PRESENCE;
+  free_slot->seq = this->request_seq_++;
+  return true;
+}
+
+// Transmit queued requests, priority ones first and then oldest first, while fewer than
+// max_in_flight_ await a reply
+void C1001Component::pump_requests_() {
+  uint8_t in_flight = 0;
+  for (const auto &request : this->requests_) {
+    if (request.frame != nullptr && request.in_flight) {
+      in_flight++;
+    }
+  }
+  
+  while (in_flight < this->max_in_flight_) {
+    C1001Request *next = nullptr;
+    for (auto &request : this->requests_) {
+      if (request.frame == nullptr || request.in_flight) {
+        continue;
+      }
+      if (next == nullptr || request.priority > next->priority ||
+          (request.priority == next->priority && (int32_t) (request.seq - next->seq) < 0)) {
+        next = &request;
+      }
+    }
+    if (next == nullptr) {
+      return;
+    }
+    
+    this->send_command_(*next->frame);
+    next->in_flight = true;
+    if (next->attempts == 0) {
+      next->first_sent_at_us = micros();
+    }
+    next->attempts++;
+    next->sent_at = millis();
+    in_flight++;
   }
-  return sum & 0xFF;
 }
 
-// Send a command using the proper DFRobot protocol format and wait for response
-bool C1001Component::send_command(uint8_t con, uint8_t cmd, uint8_t data_len, uint8_t* data, uint8_t* response_buffer) {
-  // Clear buffer
-  while (this->available()) {
-    this->read();
-    yield();
+// Give up on requests whose reply is overdue - retry them, or fail them once out of attempts
+void C1001Component::check_request_timeouts_() {
+  uint32_t now = millis();
+  for (auto &request : this->requests_) {
+    if (request.frame == nullptr || !request.in_flight || now - request.sent_at <= RESPONSE_TIMEOUT_MS) {
+      continue;
+    }
+    
+    // Initialization retries on the next update instead
+    uint8_t max_attempts = request.step == C1001_INIT_STEP ? 1 : 1 + MAX_REQUEST_RETRIES;
+    this->timeouts_++;
+    if (request.attempts < max_attempts) {
+      ESP_LOGD(TAG, "Request %02X:%02X timed out, retrying (attempt %d)", request.frame->con(),
+               request.frame->cmd(), request.attempts + 1);
+      request.in_flight = false;
+      this->retries_++;
+      continue;
+    }
+    
+    ESP_LOGD(TAG, "No response to %02X:%02X (timeout after %u ms, %d attempts)", request.frame->con(),
+             request.frame->cmd(), RESPONSE_TIMEOUT_MS, request.attempts);
+    uint8_t step = request.step;
+    request.frame = nullptr;
+    this->handle_timeout_(step);
+  }
+}
+
+// Drop everything queued or in flight; late replies are then treated as unsolicited
+void C1001Component::clear_requests_() {
+  for (auto &request : this->requests_) {
+    request.frame = nullptr;
+  }
+}
+
+bool C1001Component::requests_idle_() const {
+  for (const auto &request : this->requests_) {
+    if (request.frame != nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Time a frame of `len` bytes occupies the line: 10 bits per byte (start + 8 data + stop)
+uint32_t C1001Component::wire_time_us_(uint8_t len) const {
+  uint32_t baud = this->parent_->get_baud_rate();
+  if (baud == 0) {
+    return 0;
+  }
+  return (uint32_t) len * 10 * 1000000UL / baud;
+}
+
+void C1001Component::loop() {
+  C1001Sample sample;
+  while (this->samples_.pop(sample)) {
+    this->publish_sample_(sample);
+  }
+  if (this->night_dump_pending_) {
+    this->dump_night_block_();
+  }
+  
+  if (!this->link_in_task_) {
+    this->service_link_();
+  }
+}
+
+// One pass of the link side: receive, retire overdue requests, schedule and send. Runs
+// from loop(), or from the UART task when uart_task is enabled.
+void C1001Component::service_link_() {
+  if (this->reset_pending_.exchange(false)) {
+    this->reset_initialization_();
+  }
+  if (this->update_pending_.exchange(false)) {
+    this->run_update_();
+  }
+  if (this->capture_dump_pending_.exchange(false)) {
+    this->dump_capture_();
+  }
+  if (this->benchmark_pending_.exchange(false)) {
+    this->run_benchmark_();
+  }
+  if (this->link_stats_dump_pending_.exchange(false)) {
+    this->dump_link_stats_();
+  }
+  
+  // Consume only what the UART has already buffered - never wait for more bytes. The
+  // budget stops a babbling radar from starving the other instances sharing the loop;
+  // anything left over stays in the UART buffer for the next pass.
+  uint16_t budget = MAX_RX_BYTES_PER_LOOP;
+  uint8_t rx_chunk[C1001CaptureRing::MAX_CHUNK];
+  uint8_t rx_chunk_len = 0;
+  while (budget-- > 0 && this->available() > 0) {
+    uint8_t byte = this->read();
+    this->rx_bytes_++;
+    if (this->capture_.enabled()) {
+      rx_chunk[rx_chunk_len++] = byte;
+      if (rx_chunk_len == sizeof(rx_chunk)) {
+        this->capture_.record(millis(), false, rx_chunk, rx_chunk_len);
+        rx_chunk_len = 0;
+      }
+    }
+    
+    if (this->parser_.idle()) {
+      this->frame_started_at_ = millis();
+    }
+    this->parser_.feed(byte);
+    while (this->parser_.next()) {
+      this->handle_frame_();
+    }
+  }
+  if (rx_chunk_len > 0) {
+    this->capture_.record(millis(), false, rx_chunk, rx_chunk_len);
+  }
+  // One limiter call per pass that saw new errors; the warning reports all of them since the last one
+  uint32_t checksum_errors = this->parser_.checksum_errors();
+  uint16_t suppressed;
+  if (checksum_errors != this->checksum_errors_seen_) {
+    this->checksum_errors_seen_ = checksum_errors;
+    if (this->warn_allowed_(this->checksum_warning_, suppressed)) {
+      ESP_LOGW(TAG, "%u frames failed their checksum", checksum_errors - this->checksum_errors_logged_);
+      this->checksum_errors_logged_ = checksum_errors;
+    }
+  }
+  
+  this->check_request_timeouts_();
+  if (this->init_state_ == INIT_COMPLETE) {
+    this->schedule_polls_();
+  }
+  this->pump_requests_();
+}
+
+// True if a warning may be logged now. Warnings held back since the last one that got
+// through are counted and handed back in suppressed.
+bool C1001Component::warn_allowed_(C1001WarnLimiter &limiter, uint16_t &suppressed) {
+  uint32_t now = millis();
+  if (limiter.logged && now - limiter.last_logged < WARNING_INTERVAL_MS) {
+    if (limiter.suppressed < UINT16_MAX) {
+      limiter.suppressed++;
+    }
+    return false;
+  }
+  suppressed = limiter.suppressed;
+  limiter.suppressed = 0;
+  limiter.last_logged = now;
+  limiter.logged = true;
+  return true;
+}
+
+void C1001Component::record_round_trip_(uint8_t metric, uint32_t round_trip_us) {
+  C1001LatencyHistogram &histogram = this->latency_[metric];
+  uint8_t bucket = 0;
+  while (bucket < C1001_LATENCY_BUCKETS - 1 && round_trip_us >= LATENCY_BUCKET_MS[bucket] * 1000u) {
+    bucket++;
+  }
+  histogram.counts[bucket]++;
+  if (round_trip_us > histogram.max_us) {
+    histogram.max_us = round_trip_us;
+  }
+  this->responses_++;
+  this->round_trip_total_us_ += round_trip_us;
+}
+
+void C1001Component::dump_link_stats_() {
+  ESP_LOGI(TAG, "Link: %u bytes in, %u bytes out, %u frames, %u timeouts (%u retried)", this->rx_bytes_,
+           this->tx_bytes_, this->parser_.frames(), this->timeouts_, this->retries_);
+  ESP_LOGI(TAG, "Link: %u checksum errors, %u resyncs, %u partial frames", this->parser_.checksum_errors(),
+           this->parser_.rejected(), this->parser_.partial_frames());
+  if (this->adaptive_polling_) {
+    ESP_LOGI(TAG, "Adaptive polling: %s, %u polls skipped while vacant, %u wakeups",
+             this->vacant_watch_ ? "vacant watch" : "full", this->vacant_skipped_polls_, this->occupancy_wakeups_);
+  }
+  ESP_LOGI(TAG, "Round trip (ms buckets <2 <5 <10 <20 <50 <100 <500 >=500, max):");
+  for (uint8_t metric = 0; metric < C1001_METRIC_COUNT; metric++) {
+    const C1001LatencyHistogram &h = this->latency_[metric];
+    if (h.max_us == 0) {
+      continue;
+    }
+    ESP_LOGI(TAG, "  %02X:%02X %-20s %u %u %u %u %u %u %u %u, %u.%03u", METRICS[metric].request.con(),
+             METRICS[metric].request.cmd(), METRICS[metric].name, h.counts[0], h.counts[1], h.counts[2],
+             h.counts[3], h.counts[4], h.counts[5], h.counts[6], h.counts[7], h.max_us / 1000, h.max_us % 1000);
+  }
+}
+
+// Publish the link counters, plus the mean round trip and reply rate since the last publish
+void C1001Component::publish_link_stats_() {
+  uint32_t now = millis();
+  uint32_t responses = this->responses_ - this->responses_published_;
+  uint32_t round_trip_us = this->round_trip_total_us_ - this->round_trip_total_published_;
+  uint32_t elapsed = now - this->link_stats_published_at_;
+  
+  if (this->rx_bytes_sensor_ != nullptr) {
+    this->rx_bytes_sensor_->publish_state(this->rx_bytes_);
+  }
+  if (this->tx_bytes_sensor_ != nullptr) {
+    this->tx_bytes_sensor_->publish_state(this->tx_bytes_);
+  }
+  if (this->timeouts_sensor_ != nullptr) {
+    this->timeouts_sensor_->publish_state(this->timeouts_);
+  }
+  if (this->checksum_errors_sensor_ != nullptr) {
+    this->checksum_errors_sensor_->publish_state(this->parser_.checksum_errors());
+  }
+  if (this->resyncs_sensor_ != nullptr) {
+    this->resyncs_sensor_->publish_state(this->parser_.rejected());
+  }
+  if (this->partial_frames_sensor_ != nullptr) {
+    this->partial_frames_sensor_->publish_state(this->parser_.partial_frames());
+  }
+  if (this->round_trip_time_sensor_ != nullptr && responses > 0) {
+    this->round_trip_time_sensor_->publish_state(round_trip_us / 1000.0f / responses);
+  }
+  if (this->poll_rate_sensor_ != nullptr && elapsed > 0) {
+    this->poll_rate_sensor_->publish_state(responses * 1000.0f / elapsed);
+  }
+  if (this->vacant_skipped_polls_sensor_ != nullptr) {
+    this->vacant_skipped_polls_sensor_->publish_state(this->vacant_skipped_polls_);
+  }
+  if (this->occupancy_wakeups_sensor_ != nullptr) {
+    this->occupancy_wakeups_sensor_->publish_state(this->occupancy_wakeups_);
+  }
+  if (this->suppressed_publishes_sensor_ != nullptr) {
+    this->suppressed_publishes_sensor_->publish_state(this->suppressed_publishes_);
+  }
+  if (this->rejected_outliers_sensor_ != nullptr) {
+    this->rejected_outliers_sensor_->publish_state(this->respiration_filter_.outliers() +
+                                                   this->heart_rate_filter_.outliers());
   }
   
-  // Format according to DFRobot protocol:
-  // [0x53, 0x59, con, cmd, len_h, len_l, data..., checksum, 0x54, 0x43]
-  uint8_t cmd_buffer[20]; // Buffer for command (enough for standard commands)
-  uint8_t cmd_len = 6 + data_len + 3; // Base length + data length + checksum + end bytes
+  this->responses_published_ += responses;
+  this->round_trip_total_published_ += round_trip_us;
+  this->link_stats_published_at_ = now;
+}
+
+// Time the protocol hot paths on the device itself and log ns/op. Each case runs
+// BENCHMARK_ITERATIONS times back to back; results land in a volatile sink so the
+// compiler can't drop the work. None of these paths touch the heap; the night store
+// case allocates its private buffer before the clock starts.
+void C1001Component::run_benchmark_() {
+  static volatile uint32_t sink;
+  uint32_t start;
   
-  // Start bytes
-  cmd_buffer[0] = 0x53;
-  cmd_buffer[1] = 0x59;
+  // Request encoding, with inputs the compiler can't fold
+  volatile uint8_t con = REG_HEART;
+  volatile uint8_t cmd = CMD_GET_HEART_RATE;
+  start = micros();
+  for (uint16_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+    C1001Frame frame = make_c1001_request(con, cmd, (uint8_t) i);
+    sink = frame.bytes[7];
+  }
+  uint32_t encode_us = micros() - start;
   
-  // Command info
-  cmd_buffer[2] = con;
-  cmd_buffer[3] = cmd;
+  // Checksum over the largest frame the parser accepts
+  uint8_t frame[6 + C1001_MAX_DATA_LEN];
+  for (uint8_t i = 0; i < sizeof(frame); i++) {
+    frame[i] = i * 31;
+  }
+  start = micros();
+  for (uint16_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+    frame[0] = (uint8_t) i;
+    sink = c1001_checksum(frame, sizeof(frame));
+  }
+  uint32_t checksum_us = micros() - start;
   
-  // Data length (big-endian)
-  cmd_buffer[4] = (data_len >> 8) & 0xFF;
-  cmd_buffer[5] = data_len & 0xFF;
+  // Parsing back-to-back replies (heart rate, presence, sleep composite) on a private parser
+  uint8_t stream[3 * 11 + 18];
+  uint8_t stream_len = 0;
+  const uint8_t payloads[3][8] = {{72}, {1}, {1, 1, 15, 70, 2, 10, 20, 0}};
+  const uint8_t widths[3] = {1, 1, 8};
+  const C1001MetricId metrics[3] = {METRIC_HEART_RATE, METRIC_PRESENCE, METRIC_SLEEP_COMPOSITE};
+  for (uint8_t f = 0; f < 3; f++) {
+    const C1001Frame &request = METRICS[metrics[f]].request;
+    uint8_t *out = &stream[stream_len];
+    uint8_t pos = 0;
+    out[pos++] = 0x53;
+    out[pos++] = 0x59;
+    out[pos++] = request.con();
+    out[pos++] = request.cmd();
+    out[pos++] = 0x00;
+    out[pos++] = widths[f];
+    memcpy(&out[pos], payloads[f], widths[f]);
+    pos += widths[f];
+    out[pos] = c1001_checksum(out, pos);
+    pos++;
+    out[pos++] = 0x54;
+    out[pos++] = 0x43;
+    stream_len += pos;
+  }
+  C1001FrameParser parser;
+  uint16_t parse_iterations = BENCHMARK_ITERATIONS / 10;
+  start = micros();
+  for (uint16_t i = 0; i < parse_iterations; i++) {
+    for (uint8_t b = 0; b < stream_len; b++) {
+      parser.feed(stream[b]);
+      while (parser.next()) {
+        sink = parser.cmd();
+      }
+    }
+  }
+  uint32_t parse_us = micros() - start;
   
-  // Data bytes
-  if (data != nullptr && data_len > 0) {
-    memcpy(&cmd_buffer[6], data, data_len);
-  } else if (data_len > 0) {
-    // If no data provided but length > 0, fill with default value (0x0F)
-    for (uint8_t i = 0; i < data_len; i++) {
-      cmd_buffer[6 + i] = 0x0F;
+  // Raw -> BPM calibration lookups across every raw value
+  const float *respiration = this->respiration_calibration_;
+  const float *heart_rate = this->heart_rate_calibration_;
+  start = micros();
+  for (uint16_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+    sink = (uint32_t) respiration[(uint8_t) i] + (uint32_t) heart_rate[(uint8_t) i];
+  }
+  uint32_t scale_us = micros() - start;
+  
+  // Register map dispatch: table lookup and decoder call, without publishing
+  const uint8_t sample_payload[C1001_MAX_METRIC_WIDTH] = {3, 0};
+  start = micros();
+  for (uint16_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+    const C1001MetricDef &def = METRICS[i % C1001_METRIC_COUNT];
+    if (def.decode != nullptr) {
+      sink = (uint32_t) def.decode(C1001FrameView(sample_payload, def.width));
     }
   }
+  uint32_t dispatch_us = micros() - start;
   
-  // Calculate checksum over all bytes up to now
-  cmd_buffer[6 + data_len] = calculate_checksum(6 + data_len, cmd_buffer);
+  // Hand-off of one sample through the SPSC ring
+  C1001SpscRing<C1001Sample, 4> ring;
+  C1001Sample sample;
+  start = micros();
+  for (uint16_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+    sample.metric = i % C1001_METRIC_COUNT;
+    ring.push(sample);
+    ring.pop(sample);
+  }
+  sink = sample.metric;
+  uint32_t ring_us = micros() - start;
   
-  // End bytes
-  cmd_buffer[7 + data_len] = 0x54;
-  cmd_buffer[8 + data_len] = 0x43;
+  // Night store: heart rate and respiration every 5 s, drifting by up to 2 BPM per sample,
+  // into a private two-block store, then decoding what it retained
+  std::unique_ptr<uint8_t[]> night_buffer(new uint8_t[3 * C1001NightStore::BLOCK_SIZE]);
+  uint8_t *night_block = &night_buffer[2 * C1001NightStore::BLOCK_SIZE];
+  C1001NightStore night;
+  night.init(night_buffer.get(), 2 * C1001NightStore::BLOCK_SIZE);
+  start = micros();
+  for (uint16_t i = 0; i < BENCHMARK_ITERATIONS; i++) {
+    float drift = (i / 2 * 7 % 5) * 0.5f;
+    if (i % 2 == 0) {
+      night.record(i / 2 * 5, NIGHT_HEART_RATE, 60.0f + drift);
+    } else {
+      night.record(i / 2 * 5, NIGHT_RESPIRATION, 14.0f + drift);
+    }
+  }
+  uint32_t night_record_us = micros() - start;
+  float night_sum = 0;
+  uint32_t night_records = 0;
+  start = micros();
+  for (uint32_t block = night.first_block(); block < night.end_block(); block++) {
+    night.read_block(block, night_block);
+    night_records += C1001NightStore::decode_block(
+        night_block, [](void *context, uint32_t, uint8_t, float value) { *(float *) context += value; }, &night_sum);
+  }
+  uint32_t night_decode_us = micros() - start;
+  sink = (uint32_t) night_sum;
   
-  // Print the complete command for debugging
-  char debug_str[64];
-  strcpy(debug_str, "Sending: ");
-  for (uint8_t i = 0; i < cmd_len; i++) {
-    char hex[5];
-    sprintf(hex, "%02X:", cmd_buffer[i]);
-    strcat(debug_str, hex);
+  uint32_t parsed_frames = parse_iterations * 3;
+  ESP_LOGI(TAG, "Benchmark (%u iterations, ns/op):", BENCHMARK_ITERATIONS);
+  ESP_LOGI(TAG, "  Encode request: %u", encode_us * 1000 / BENCHMARK_ITERATIONS);
+  ESP_LOGI(TAG, "  Checksum (%u bytes): %u", (unsigned) sizeof(frame), checksum_us * 1000 / BENCHMARK_ITERATIONS);
+  ESP_LOGI(TAG, "  Parse frame: %u (%u per byte, %u frames)", parse_us * 1000 / parsed_frames,
+           parse_us * 1000 / (parse_iterations * stream_len), parser.frames());
+  ESP_LOGI(TAG, "  Calibrate respiration + heart rate: %u", scale_us * 1000 / BENCHMARK_ITERATIONS);
+  ESP_LOGI(TAG, "  Register map dispatch (no publishing): %u", dispatch_us * 1000 / BENCHMARK_ITERATIONS);
+  ESP_LOGI(TAG, "  Sample ring push + pop: %u", ring_us * 1000 / BENCHMARK_ITERATIONS);
+  ESP_LOGI(TAG, "  Night store record: %u (%.2f bytes/sample, 9 unencoded)", night_record_us * 1000 / BENCHMARK_ITERATIONS,
+           (float) night.encoded_bytes() / night.samples());
+  if (night_records > 0) {
+    ESP_LOGI(TAG, "  Night store decode: %u per record", night_decode_us * 1000 / night_records);
+  }
+  (void) sink;
+}
+
+// len bytes as upper-case hex into out, which holds 2 * len + 1 chars
+static void format_hex(const uint8_t *data, uint16_t len, char *out) {
+  static const char HEX_DIGITS[] = "0123456789ABCDEF";
+  for (uint16_t i = 0; i < len; i++) {
+    out[2 * i] = HEX_DIGITS[data[i] >> 4];
+    out[2 * i + 1] = HEX_DIGITS[data[i] & 0x0F];
+  }
+  out[2 * len] = '\0';
+}
+
+// Log the capture as hex lines of raw ring bytes. Concatenating the lines in offset order
+// gives back the records (see C1001CaptureRing), ready to replay through the parser.
+void C1001Component::dump_capture_() {
+  if (!this->capture_.enabled()) {
+    ESP_LOGW(TAG, "Capture is disabled, set capture_size to enable it");
+    return;
   }
-  // Remove the last colon
-  debug_str[strlen(debug_str)-1] = '\0';
-  ESP_LOGD(TAG, "%s", debug_str);
   
-  // Send full command
-  for (uint8_t i = 0; i < cmd_len; i++) {
-    this->write(cmd_buffer[i]);
-    delay(2); // Small delay between bytes
-    yield();
+  ESP_LOGI(TAG, "Capture: %u bytes, %u older records overwritten", this->capture_.used(),
+           this->capture_.dropped());
+  uint8_t chunk[DUMP_LINE_BYTES];
+  char line[2 * DUMP_LINE_BYTES + 1];
+  uint16_t offset = 0;
+  uint16_t len;
+  while ((len = this->capture_.read(offset, chunk, sizeof(chunk))) > 0) {
+    format_hex(chunk, len, line);
+    ESP_LOGI(TAG, "capture %04X: %s", offset, line);
+    offset += len;
+  }
+}
+
+// Vitals go into the night store with every sample, the state channels only on change
+void C1001Component::record_night_(uint8_t metric, float value) {
+  uint32_t now_s = millis() / 1000;
+  switch (metric) {
+    case METRIC_HEART_RATE:
+      this->night_store_.record(now_s, NIGHT_HEART_RATE, value);
+      break;
+    case METRIC_RESPIRATION:
+      this->night_store_.record(now_s, NIGHT_RESPIRATION, value);
+      break;
+    case METRIC_SLEEP_STATE:
+      this->night_store_.record_change(now_s, NIGHT_SLEEP_STATE, value);
+      break;
+    case METRIC_IN_BED:
+      this->night_store_.record_change(now_s, NIGHT_IN_BED, value);
+      break;
+    default:
+      break;
+  }
+}
+
+// Start streaming the night store to the log. The blocks written up to now go out one per
+// loop pass; block times are seconds since boot, so the header gives the current clock.
+void C1001Component::dump_night_store() {
+  if (!this->night_store_.enabled()) {
+    ESP_LOGW(TAG, "Night store is disabled, set night_store_size to enable it");
+    return;
   }
   
-  // Wait for response with timeout
-  uint32_t start = millis();
-  uint32_t timeout = 2000; // 2 second timeout
+  const C1001NightStore &store = this->night_store_;
+  ESP_LOGI(TAG, "Night store: blocks %u-%u, %u of %u bytes, %u samples in %u bytes, clock %u s",
+           store.first_block(), store.end_block(), store.used(), store.capacity(), store.samples(),
+           store.encoded_bytes(), millis() / 1000);
+  this->night_dump_next_ = store.first_block();
+  this->night_dump_end_ = store.end_block();
+  this->night_dump_pending_ = true;
+}
+
+// Log the next block of a dump as hex lines, skipping any dropped since the dump started
+void C1001Component::dump_night_block_() {
+  if (this->night_dump_next_ < this->night_store_.first_block()) {
+    ESP_LOGW(TAG, "Night store: blocks %u-%u dropped during the dump", this->night_dump_next_,
+             this->night_store_.first_block() - 1);
+    this->night_dump_next_ = this->night_store_.first_block();
+  }
+  uint8_t block[C1001NightStore::BLOCK_SIZE];
+  if (this->night_dump_next_ >= this->night_dump_end_ ||
+      !this->night_store_.read_block(this->night_dump_next_, block)) {
+    ESP_LOGI(TAG, "Night store: dump complete");
+    this->night_dump_pending_ = false;
+    return;
+  }
   
-  // Collect all bytes for debugging
-  uint8_t recv_buffer[64] = {0};
-  uint8_t recv_pos = 0;
-  bool found_start = false;
-  bool found_end = false;
+  char line[2 * DUMP_LINE_BYTES + 1];
+  for (uint16_t offset = 0; offset < sizeof(block); offset += DUMP_LINE_BYTES) {
+    format_hex(&block[offset], DUMP_LINE_BYTES, line);
+    ESP_LOGI(TAG, "night %u+%02X: %s", this->night_dump_next_, offset, line);
+  }
+  this->night_dump_next_++;
+}
+
+// A complete, checksum-valid frame is held by parser_
+void C1001Component::handle_frame_() {
+  uint8_t con = this->parser_.con();
+  uint8_t cmd = this->parser_.cmd();
   
-  // Simple response detection - just look for start and end markers
-  while (millis() - start < timeout) {
-    if (this->available() > 0) {
-      uint8_t byte = this->read();
-      
-      // Store in buffer for debugging
-      if (recv_pos < sizeof(recv_buffer) - 1) {
-        recv_buffer[recv_pos++] = byte;
-      }
-      
-      // Look for start pattern (0x53, 0x59)
-      if (byte == 0x53) {
-        found_start = true;
-      }
-      
-      // Look for end pattern (0x54, 0x43)
-      if (byte == 0x43 && recv_pos > 1 && recv_buffer[recv_pos-2] == 0x54) {
-        found_end = true;
-      }
-      
-      // If we've found both start and end markers, we have a complete response
-      if (found_start && found_end) {
-        // Detect data bytes - typically position 6 for first data byte
-        uint8_t data_byte = 0;
-        if (recv_pos > 8) { // Ensure we have enough bytes
-          // Simple response - just grab the likely data byte
-          data_byte = recv_buffer[6]; // First data byte is usually what we want
-        }
-        
-        // Log the response
-        char resp_str[128] = "Received: ";
-        for (uint8_t i = 0; i < recv_pos; i++) {
-          char hex[5];
-          sprintf(hex, "%02X:", recv_buffer[i]);
-          strcat(resp_str, hex);
-        }
-        // Remove the last colon
-        resp_str[strlen(resp_str)-1] = '\0';
-        ESP_LOGD(TAG, "%s - Data: %02X", resp_str, data_byte);
-        
-        // Copy to response buffer if provided
-        if (response_buffer != nullptr && recv_pos > 0) {
-          memcpy(response_buffer, recv_buffer, recv_pos);
-        }
-        
-        return true;
-      }
+  ESP_LOGV(TAG, "RX %02X:%02X, %u data bytes", con, cmd, this->parser_.payload().size());
+  
+  // Correlate the reply with its request by control and command byte
+  for (auto &request : this->requests_) {
+    if (request.frame == nullptr || !request.in_flight || request.frame->con() != con ||
+        request.frame->cmd() != cmd) {
+      continue;
+    }
+    
+    uint8_t step = request.step;
+    request.frame = nullptr;
+    if (step != C1001_INIT_STEP) {
+      this->record_round_trip_(step, micros() - request.first_sent_at_us);
     }
-    delay(5); // Small delay to avoid CPU hogging
-    yield();
+    this->handle_response_(step, this->parser_.payload());
+    return;
+  }
+  
+  this->handle_report_(con, cmd);
+}
+
+// Route a frame nobody asked for. The radar pushes presence, movement, vitals and
+// sleep updates on its own; those go to the same decoders as polled replies.
+void C1001Component::handle_report_(uint8_t con, uint8_t cmd) {
+  if (!this->push_reports_ || (cmd & 0x80) != 0 || this->init_state_ != INIT_COMPLETE) {
+    ESP_LOGV(TAG, "Ignoring frame %02X:%02X - no matching request in flight", con, cmd);
+    return;
   }
   
-  // If we get here, we timed out
-  if (recv_pos > 0) {
-    // Log what we received before timeout
-    char resp_str[128] = "Partial response: ";
-    for (uint8_t i = 0; i < recv_pos; i++) {
-      char hex[5];
-      sprintf(hex, "%02X:", recv_buffer[i]);
-      strcat(resp_str, hex);
+  for (uint8_t metric = 0; metric < C1001_METRIC_COUNT; metric++) {
+    const C1001Frame &request = METRICS[metric].request;
+    if (request.con() != con || (request.cmd() & 0x7F) != cmd) {
+      continue;
+    }
+    
+    ESP_LOGV(TAG, "Push report %02X:%02X for %s", con, cmd, METRICS[metric].name);
+    if (this->accept_metric_(metric, this->parser_.payload(), true)) {
+      this->last_push_[metric] = millis();
+      this->last_successful_read_ = this->last_push_[metric];
+      this->consecutive_errors_ = 0;
     }
-    // Remove the last colon
-    resp_str[strlen(resp_str)-1] = '\0';
-    ESP_LOGW(TAG, "%s (timeout after %d ms)", resp_str, timeout);
-  } else {
-    ESP_LOGW(TAG, "No response received (timeout after %d ms)", timeout);
+    return;
+  }
+  
+  ESP_LOGV(TAG, "Unhandled push report %02X:%02X", con, cmd);
+}
+
+// True if the radar has been reporting this metric by itself, so polling it is wasted traffic
+bool C1001Component::is_push_covered_(uint8_t metric, uint32_t now) const {
+  return this->push_reports_ && this->last_push_[metric] != 0 &&
+         now - this->last_push_[metric] < PUSH_COVERAGE_MS;
+}
+
+void C1001Component::handle_response_(uint8_t step, C1001FrameView payload) {
+  if (step == C1001_INIT_STEP) {
+    this->handle_init_response_(payload);
+    return;
+  }
+  
+  if (!this->accept_metric_(step, payload, false)) {
+    this->handle_timeout_(step);
+    return;
+  }
+  this->last_successful_read_ = millis();
+  this->consecutive_errors_ = 0;
+}
+
+void C1001Component::handle_timeout_(uint8_t step) {
+  if (step == C1001_INIT_STEP) {
+    this->init_retry_count_++;
+    this->init_mode_set_sent_ = false;
+    ESP_LOGW(TAG, "Initialization step %d got no response, will retry next update", this->init_state_);
+    return;
   }
   
-  return false;
+  this->consecutive_errors_++;
+  uint16_t suppressed;
+  if (this->warn_allowed_(this->link_warnings_[step], suppressed)) {
+    ESP_LOGW(TAG, "Failed to read %s, consecutive errors: %d [%u similar suppressed]", METRICS[step].name,
+             this->consecutive_errors_, suppressed);
+  }
+  
+  // If we have too many consecutive errors, reset initialization
+  if (this->consecutive_errors_ >= MAX_CONSECUTIVE_ERRORS) {
+    ESP_LOGE(TAG, "Too many consecutive sensor errors, resetting initialization");
+    this->reset_initialization_();
+  }
 }
 
 void C1001Component::update() {
+  this->publish_link_stats_();
+  this->publish_statistics_();
+  this->publish_overdue_();
+  // Ends the session even when the samples that would have done it stop coming
+  this->update_session_();
+  
+  // The UART task owns the link, so it picks the update up on its next pass
+  if (this->link_in_task_) {
+    this->update_pending_ = true;
+    return;
+  }
+  this->run_update_();
+}
+
+void C1001Component::run_update_() {
   ESP_LOGV(TAG, "Running update");
   
-  // If we aren't fully initialized yet
+  // If we aren't fully initialized yet - init steps go out one at a time
   if (this->init_state_ != INIT_COMPLETE) {
-    static uint8_t retry_count = 0;
-    bool success = false;
-    uint8_t dummy_byte = 0x0F;
-    uint8_t response[20] = {0};
-    
-    // Direct binary protocol implementation using the DFRobot format
-    switch (this->init_state_) {
-      case INIT_CREATED: {
-        ESP_LOGD(TAG, "Attempting direct sensor initialization [attempt: %d]", retry_count + 1);
-        
-        // Flush buffer and try a basic command to check if sensor is alive
-        // Use LED query command as a basic test
-        this->flush();
-        
-        // Debug the bytes we're sending - this is the new send_command
-        ESP_LOGD(TAG, "Calling send_command with REG_CONFIG=%d, CMD_GET_LED=%d", REG_CONFIG, CMD_GET_LED);
-        success = this->send_command(REG_CONFIG, CMD_GET_LED, 1, &dummy_byte, response);
-        
-        if (success) {
-          ESP_LOGI(TAG, "Sensor is responding - proceeding with initialization");
-          this->init_state_ = INIT_BEGIN_DONE;
-          retry_count = 0;
-          return;
-        } else {
-          retry_count++;
-          ESP_LOGW(TAG, "No response from sensor, will retry next update");
-          return;
-        }
-      }
-      
-      case INIT_BEGIN_DONE: {
-        ESP_LOGD(TAG, "Setting sleep mode");
-        
-        // First query current mode
-        ESP_LOGD(TAG, "Calling send_command to query work mode");
-        success = this->send_command(REG_WORK_MODE, CMD_GET_WORK_MODE, 1, &dummy_byte, response);
-        if (!success) {
-          retry_count++;
-          ESP_LOGW(TAG, "Work mode query failed, will retry next update");
-          return;
-        }
-        
-        // If not already in sleep mode (0x01), set it
-        ESP_LOGD(TAG, "Current mode: %02X (sleep mode is: %02X)", response[6], MODE_SLEEP);
-        if (response[6] != MODE_SLEEP) {
-          uint8_t sleep_mode = MODE_SLEEP;
-          ESP_LOGD(TAG, "Setting sleep mode with send_command");
-          success = this->send_command(REG_WORK_MODE, CMD_SET_WORK_MODE, 1, &sleep_mode, response);
-          if (!success) {
-            retry_count++;
-            ESP_LOGW(TAG, "Sleep mode command failed, will retry next update");
-            return;
-          }
-        }
-        
-        ESP_LOGI(TAG, "Sleep mode set successfully");
-        this->init_state_ = INIT_SLEEP_MODE_DONE;
-        retry_count = 0;
-        return;
-      }
-      
-      case INIT_SLEEP_MODE_DONE: {
-        ESP_LOGD(TAG, "Configuring LED");
-        
-        // Configure LED (0x01 = ON)
-        uint8_t led_on = 0x01;
-        ESP_LOGD(TAG, "Calling send_command to set LED");
-        success = this->send_command(REG_CONFIG, CMD_SET_LED, 1, &led_on, response);
-        if (!success) {
-          retry_count++;
-          ESP_LOGW(TAG, "LED command failed, will retry next update");
-          return;
-        }
-        
-        ESP_LOGI(TAG, "LED configured successfully");
-        this->init_state_ = INIT_LED_DONE;
-        retry_count = 0;
-        return;
-      }
-      
-      case INIT_LED_DONE: {
-        ESP_LOGD(TAG, "Resetting sensor");
-        
-        // Reset sensor - uses REG_CONFIG
-        ESP_LOGD(TAG, "Calling send_command to reset sensor");
-        success = this->send_command(REG_CONFIG, CMD_RESET, 1, &dummy_byte, response);
-        if (!success) {
-          retry_count++;
-          ESP_LOGW(TAG, "Reset command failed, will retry next update");
-          return;
-        }
-        
-        // Wait a bit after reset
-        delay(100);
-        yield();
-        
-        ESP_LOGI(TAG, "Sensor reset successful");
-        this->init_state_ = INIT_COMPLETE;
-        this->sensor_initialized_ = true;
-        this->consecutive_errors_ = 0;
-        this->last_successful_read_ = millis();
-        ESP_LOGI(TAG, "C1001 initialization complete!");
-        retry_count = 0;
-        return;
-      }
-        
-      default: {
-        // Safety fallback
-        ESP_LOGW(TAG, "Unknown initialization state: %d", this->init_state_);
-        this->init_state_ = INIT_CREATED;
-        retry_count = 0;
-        break;
-      }
+    if (this->requests_idle_()) {
+      this->send_init_step_();
+    } else {
+      ESP_LOGV(TAG, "Initialization step still in flight, skipping update");
     }
-    
-    // Return after handling initialization
     return;
   }
   
@@ -408,494 +996,620 @@ void C1001Component::update() {
   if (now - this->last_successful_read_ > SENSOR_TIMEOUT_MS) {
     ESP_LOGE(TAG, "Sensor timeout - no successful read in %u ms", 
              now - this->last_successful_read_);
-    this->reset_initialization();
+    this->reset_initialization_();
     return;
   }
   
-  // We'll use a more sophisticated approach to prioritize HR and respiration readings
-  // while still cycling through other metrics at lower frequency
-  static uint8_t read_step = 0;
-  static uint8_t vital_count = 0;
-  bool success = false;
-  uint8_t dummy_byte = 0x0F;
-  uint8_t response[20] = {0};
-  
-  // Define current step based on priority pattern:
-  // Vital signs (HR + Resp) are read at 3x frequency of other readings
-  uint8_t current_step;
-  if (vital_count < 2) {
-    // Read vital signs (breathing or heart rate) 2 out of 3 cycles
-    vital_count++;
+  ESP_LOGV(TAG, "Update complete - %d requests pending", C1001_QUEUE_SIZE - this->free_request_slots_());
+}
+
+// Queue every metric whose deadline has passed. Only metrics with a configured sensor
+// have an interval; everything else was left out of the plan at codegen time.
+void C1001Component::schedule_polls_() {
+  uint32_t now = millis();
+  bool vacant = this->in_vacant_watch_(now);
+  for (uint8_t metric = 0; metric < C1001_METRIC_COUNT; metric++) {
+    uint32_t interval = this->poll_interval_[metric];
+    if (interval == 0 || (int32_t) (now - this->next_poll_[metric]) < 0) {
+      continue;
+    }
     
-    // Alternate between breathing and heart rate
-    if (vital_count % 2 == 1) {
-      current_step = 2;  // Get breathing value
-    } else {
-      current_step = 3;  // Get heart rate value
+    // An empty room only needs the registers that tell us someone is back
+    if (vacant) {
+      if (!this->watches_occupancy_(metric)) {
+        this->vacant_skipped_polls_++;
+        this->next_poll_[metric] = now + interval;
+        continue;
+      }
+      interval = std::max(interval, this->vacant_interval_);
     }
-  } else {
-    // Every 3rd cycle, read a non-vital metric
-    vital_count = 0;
     
-    // Use a reduced range for non-vital metrics if we're only interested in vitals
-    // This cycles through presence, movement, and sleep composite data
-    current_step = read_step;
-    read_step = (read_step + 1) % 14;
+    // Leave anything the radar has been pushing to its own reports
+    if (this->is_push_covered_(metric, now)) {
+      ESP_LOGV(TAG, "%s is covered by push reports, not polling", METRICS[metric].name);
+      this->next_poll_[metric] = now + interval;
+      continue;
+    }
     
-    // Skip vital signs steps (2 and 3) during the regular cycle
-    // as they're already read in the priority cycle
-    if (current_step == 2 || current_step == 3) {
-      current_step = (current_step + 1) % 14;
+    // A full queue keeps the deadline so the metric goes out on a later loop; a request
+    // for the same register still pending already covers this one
+    if (this->free_request_slots_() == 0) {
+      return;
     }
+    if (this->enqueue_request_(METRICS[metric].request, metric)) {
+      ESP_LOGV(TAG, "Reading %s", METRICS[metric].name);
+    }
+    this->next_poll_[metric] = now + interval;
   }
-  
-  // Process the current step
-  switch (current_step) {
-    case 0: {
-      // Get human presence data using the proper protocol
-      ESP_LOGD(TAG, "Reading presence data with REG_BASIC_HUMAN=%d, CMD_GET_PRESENCE=%d", REG_BASIC_HUMAN, CMD_GET_PRESENCE);
-      success = this->send_command(REG_BASIC_HUMAN, CMD_GET_PRESENCE, 1, &dummy_byte, response);
-      
-      if (success) {
-        // Extract presence value from response[6]
-        int raw_presence = response[6];
-        ESP_LOGD(TAG, "Raw presence value: %d", raw_presence);
-        
-        // Based on observations: high values (~95) when nobody is present, 
-        // low values (<50) when someone is present
-        // This suggests the raw value is inverted from what we'd expect
-        bool is_present = (raw_presence < 50);  // Threshold based on observations
-        
-        if (this->presence_sensor_ != nullptr) {
-          // Report the raw value for analysis
-          this->presence_sensor_->publish_state(raw_presence);
-        }
-        if (this->person_detected_ != nullptr) {
-          // Publish inverted interpretation
-          this->person_detected_->publish_state(is_present);
-          ESP_LOGI(TAG, "Person detected: %s (raw value: %d)", is_present ? "YES" : "NO", raw_presence);
-        }
-      }
-      break;
+}
+
+uint8_t C1001Component::free_request_slots_() const {
+  uint8_t free_slots = 0;
+  for (const auto &request : this->requests_) {
+    if (request.frame == nullptr) {
+      free_slots++;
     }
-    
-    case 1: {
-      // Get movement data
-      ESP_LOGD(TAG, "Reading movement data with REG_BASIC_HUMAN=%d, CMD_GET_MOVEMENT=%d", REG_BASIC_HUMAN, CMD_GET_MOVEMENT);
-      success = this->send_command(REG_BASIC_HUMAN, CMD_GET_MOVEMENT, 1, &dummy_byte, response);
+  }
+  return free_slots;
+}
+
+void C1001Component::add_polled_metric(C1001MetricId metric, uint32_t interval_ms) {
+  if (metric >= C1001_METRIC_COUNT) {
+    return;
+  }
+  // Several sensors can share one register (e.g. the sleep composite); the fastest wins.
+  // The default interval isn't known until setup(), which settles the contest for it.
+  if (interval_ms == 0) {
+    this->poll_default_[metric] = true;
+  } else if (this->poll_interval_[metric] == 0 || interval_ms < this->poll_interval_[metric]) {
+    this->poll_interval_[metric] = interval_ms;
+  }
+}
+
+void C1001Component::send_init_step_() {
+  // Direct binary protocol implementation using the DFRobot format
+  switch (this->init_state_) {
+    case INIT_CREATED: {
+      ESP_LOGD(TAG, "Attempting direct sensor initialization [attempt: %d]", this->init_retry_count_ + 1);
       
-      if (success) {
-        // Extract movement value from response[6]
-        int movement = response[6];
-        ESP_LOGD(TAG, "Movement value: %d", movement);
-        
-        if (movement >= 0 && movement <= 2 && this->movement_sensor_ != nullptr) {
-          this->movement_sensor_->publish_state(movement);
-        }
-      }
+      // Try a basic command to check if sensor is alive
+      // Use LED query command as a basic test
+      ESP_LOGD(TAG, "Calling send_command_ with REG_CONFIG=%d, CMD_GET_LED=%d", REG_CONFIG, CMD_GET_LED);
+      this->enqueue_request_(FRAME_GET_LED, C1001_INIT_STEP);
       break;
     }
     
-    case 2: {
-      // Get breathing value - HIGH PRIORITY MEASUREMENT
-      ESP_LOGD(TAG, "Reading breathing data with REG_BREATH=%d, CMD_GET_BREATHING=%d", REG_BREATH, CMD_GET_BREATHING);
-      success = this->send_command(REG_BREATH, CMD_GET_BREATHING, 1, &dummy_byte, response);
+    case INIT_BEGIN_DONE: {
+      ESP_LOGD(TAG, "Setting sleep mode");
       
-      if (success) {
-        // Extract breathing value from response[6]
-        // Official spec: Breath Measurement Range: 10-25 breaths per minute
-        uint8_t raw_breathing = response[6];
-        
-        // Check if value is realistic for BPM or needs scaling
-        float breathing;
-        
-        // Apply scaling based on sensor specification range of 10-25 BPM
-        if (raw_breathing < 8) {
-          // Too low to be physiologically realistic, scale up
-          // Map 0-10 raw values to the 10-15 BPM range (lower half of spec)
-          breathing = 10.0f + ((float)raw_breathing / 10.0f) * 5.0f;
-          ESP_LOGD(TAG, "Scaled low respiration from raw %d to %.1f BPM", raw_breathing, breathing);
-        } else if (raw_breathing > 25 && raw_breathing < 100) {
-          // Between official range max and likely scale value, map to official range
-          breathing = 10.0f + ((float)(raw_breathing - 25) / 75.0f) * 15.0f;
-          ESP_LOGD(TAG, "Scaled mid respiration from raw %d to %.1f BPM", raw_breathing, breathing);
-        } else if (raw_breathing >= 100) {
-          // Likely on a different scale entirely (0-255), map to official range
-          breathing = 10.0f + ((float)raw_breathing / 255.0f) * 15.0f;
-          ESP_LOGD(TAG, "Scaled high respiration from raw %d to %.1f BPM", raw_breathing, breathing);
-        } else {
-          // Already within the official range of 10-25 BPM
-          breathing = raw_breathing;
-          ESP_LOGD(TAG, "Respiration value (direct): %.1f BPM", breathing);
-        }
-        
-        // Check against official spec range (10-25 BPM)
-        if (breathing >= 10.0f && breathing <= 25.0f && this->respiration_sensor_ != nullptr) {
-          this->respiration_sensor_->publish_state(breathing);
-        } else {
-          ESP_LOGW(TAG, "Respiration value outside specified range (10-25 BPM): %.1f BPM (raw: %d)", 
-                  breathing, raw_breathing);
-          // Still publish if within more generous limits, just with a warning
-          if (breathing >= 8.0f && breathing <= 30.0f && this->respiration_sensor_ != nullptr) {
-            this->respiration_sensor_->publish_state(breathing);
-          }
-        }
-      }
+      // First query current mode
+      ESP_LOGD(TAG, "Calling send_command_ to query work mode");
+      this->init_mode_set_sent_ = false;
+      this->enqueue_request_(FRAME_GET_WORK_MODE, C1001_INIT_STEP);
       break;
     }
     
-    case 3: {
-      // Get heart rate data - HIGH PRIORITY MEASUREMENT
-      ESP_LOGD(TAG, "Reading heart rate data with REG_HEART=%d, CMD_GET_HEART_RATE=%d", REG_HEART, CMD_GET_HEART_RATE);
-      success = this->send_command(REG_HEART, CMD_GET_HEART_RATE, 1, &dummy_byte, response);
+    case INIT_SLEEP_MODE_DONE: {
+      ESP_LOGD(TAG, "Configuring LED");
       
-      if (success) {
-        // Extract heart rate value from response[6]
-        // Official spec: Heart Rate Measurement Range: 60-100 beats per minute
-        uint8_t raw_heart = response[6];
-        
-        // Check if value is realistic for BPM or needs scaling
-        float heart;
-        
-        // Apply scaling based on sensor specification range of 60-100 BPM
-        if (raw_heart < 30) {
-          // Too low to be physiologically realistic, scale up
-          // Map 0-30 raw values to the 60-75 BPM range (lower half of spec)
-          heart = 60.0f + ((float)raw_heart / 30.0f) * 15.0f;
-          ESP_LOGD(TAG, "Scaled low heart rate from raw %d to %.1f BPM", raw_heart, heart);
-        } else if (raw_heart > 100 && raw_heart < 150) {
-          // Between official range max and likely scale threshold
-          heart = 60.0f + ((float)(raw_heart - 30) / 120.0f) * 40.0f;
-          ESP_LOGD(TAG, "Scaled mid heart rate from raw %d to %.1f BPM", raw_heart, heart);
-        } else if (raw_heart >= 150) {
-          // Likely on a different scale entirely (0-255), map to official range
-          heart = 60.0f + ((float)raw_heart / 255.0f) * 40.0f;
-          ESP_LOGD(TAG, "Scaled high heart rate from raw %d to %.1f BPM", raw_heart, heart);
-        } else if (raw_heart >= 30 && raw_heart < 60) {
-          // Below spec but potentially valid, apply gentle scaling
-          heart = 60.0f - (60.0f - raw_heart) * 0.5f;  // Scale up but preserve some of the difference
-          ESP_LOGD(TAG, "Adjusted below-range heart rate from raw %d to %.1f BPM", raw_heart, heart);
-        } else {
-          // Already within the official range of 60-100 BPM
-          heart = raw_heart;
-          ESP_LOGD(TAG, "Heart rate value (direct): %.1f BPM", heart);
-        }
-        
-        // Check against official spec range (60-100 BPM)
-        if (heart >= 60.0f && heart <= 100.0f && this->heart_rate_sensor_ != nullptr) {
-          this->heart_rate_sensor_->publish_state(heart);
-        } else {
-          ESP_LOGW(TAG, "Heart rate value outside specified range (60-100 BPM): %.1f BPM (raw: %d)", 
-                  heart, raw_heart);
-          // Still publish if within more generous heart rate limits, just with a warning
-          if (heart >= 40.0f && heart <= 120.0f && this->heart_rate_sensor_ != nullptr) {
-            this->heart_rate_sensor_->publish_state(heart);
-          }
-        }
-      }
+      // Configure LED (0x01 = ON)
+      ESP_LOGD(TAG, "Calling send_command_ to set LED");
+      this->enqueue_request_(FRAME_SET_LED_ON, C1001_INIT_STEP);
       break;
     }
     
-    case 4: {
-      // Get in-bed status
-      ESP_LOGD(TAG, "Reading in-bed status with REG_SLEEP=%d, CMD_GET_IN_BED=%d", REG_SLEEP, CMD_GET_IN_BED);
-      success = this->send_command(REG_SLEEP, CMD_GET_IN_BED, 1, &dummy_byte, response);
+    case INIT_LED_DONE: {
+      ESP_LOGD(TAG, "Resetting sensor");
       
-      if (success) {
-        // Extract in-bed value from response[6]
-        int in_bed = response[6];
-        this->in_bed_ = in_bed;
-        ESP_LOGD(TAG, "In-bed status: %d (0=out of bed, 1=in bed)", in_bed);
-        
-        if (this->in_bed_sensor_ != nullptr) {
-          this->in_bed_sensor_->publish_state(in_bed);
-        }
-      }
+      // Reset sensor - uses REG_CONFIG
+      ESP_LOGD(TAG, "Calling send_command_ to reset sensor");
+      this->enqueue_request_(FRAME_RESET, C1001_INIT_STEP);
       break;
     }
     
-    case 5: {
-      // Get sleep state 
-      ESP_LOGD(TAG, "Reading sleep state with REG_SLEEP=%d, CMD_GET_SLEEP_STATE=%d", REG_SLEEP, CMD_GET_SLEEP_STATE);
-      success = this->send_command(REG_SLEEP, CMD_GET_SLEEP_STATE, 1, &dummy_byte, response);
-      
-      if (success) {
-        // Extract sleep state value from response[6]
-        int sleep_state = response[6];
-        this->sleep_state_ = sleep_state;
-        ESP_LOGD(TAG, "Sleep state: %d (0=Deep, 1=Light, 2=Awake, 3=None)", sleep_state);
-        
-        if (this->sleep_state_sensor_ != nullptr) {
-          this->sleep_state_sensor_->publish_state(sleep_state);
-        }
-      }
+    default: {
+      // Safety fallback
+      ESP_LOGW(TAG, "Unknown initialization state: %d", this->init_state_);
+      this->init_state_ = INIT_CREATED;
+      this->init_retry_count_ = 0;
       break;
     }
-    
-    case 6: {
-      // Get sleep quality score
-      ESP_LOGD(TAG, "Reading sleep quality with REG_SLEEP=%d, CMD_GET_SLEEP_QUALITY=%d", REG_SLEEP, CMD_GET_SLEEP_QUALITY);
-      success = this->send_command(REG_SLEEP, CMD_GET_SLEEP_QUALITY, 1, &dummy_byte, response);
-      
-      if (success) {
-        // Extract sleep quality value from response[6]
-        int sleep_quality = response[6];
-        this->sleep_quality_score_ = sleep_quality;
-        ESP_LOGD(TAG, "Sleep quality score: %d (0-100)", sleep_quality);
-        
-        if (this->sleep_quality_sensor_ != nullptr) {
-          this->sleep_quality_sensor_->publish_state(sleep_quality);
-        }
-      }
+  }
+}
+
+void C1001Component::handle_init_response_(C1001FrameView payload) {
+  switch (this->init_state_) {
+    case INIT_CREATED: {
+      ESP_LOGI(TAG, "Sensor is responding - proceeding with initialization");
+      this->init_state_ = INIT_BEGIN_DONE;
+      this->init_retry_count_ = 0;
       break;
     }
     
-    case 7: {
-      // Get sleep quality rating
-      ESP_LOGD(TAG, "Reading sleep quality rating with REG_SLEEP=%d, CMD_GET_SLEEP_QUALITY_RATING=%d", REG_SLEEP, CMD_GET_SLEEP_QUALITY_RATING);
-      success = this->send_command(REG_SLEEP, CMD_GET_SLEEP_QUALITY_RATING, 1, &dummy_byte, response);
-      
-      if (success) {
-        // Extract sleep quality rating from response[6]
-        int rating = response[6];
-        this->sleep_quality_rating_ = rating;
-        ESP_LOGD(TAG, "Sleep quality rating: %d (0=None, 1=Good, 2=Average, 3=Poor)", rating);
-        
-        if (this->sleep_quality_rating_sensor_ != nullptr) {
-          this->sleep_quality_rating_sensor_->publish_state(rating);
+    case INIT_BEGIN_DONE: {
+      // If not already in sleep mode, set it - the reply to that comes back through here too
+      if (!this->init_mode_set_sent_) {
+        ESP_LOGD(TAG, "Current mode: %02X (sleep mode is: %02X)", payload[0], MODE_SLEEP);
+        if (payload[0] != MODE_SLEEP) {
+          ESP_LOGD(TAG, "Setting sleep mode with send_command_");
+          this->init_mode_set_sent_ = this->enqueue_request_(FRAME_SET_SLEEP_MODE, C1001_INIT_STEP);
+          return;
         }
       }
-      break;
-    }
-    
-    case 8: {
-      // Get abnormal struggle status
-      ESP_LOGD(TAG, "Reading abnormal struggle status with REG_SLEEP=%d, CMD_GET_ABNORMAL_STRUGGLE=%d", REG_SLEEP, CMD_GET_ABNORMAL_STRUGGLE);
-      success = this->send_command(REG_SLEEP, CMD_GET_ABNORMAL_STRUGGLE, 1, &dummy_byte, response);
       
-      if (success) {
-        // Extract abnormal struggle status from response[6]
-        int struggle = response[6];
-        ESP_LOGD(TAG, "Abnormal struggle: %d (0=None, 1=Normal, 2=Abnormal)", struggle);
-        
-        if (this->abnormal_struggle_sensor_ != nullptr) {
-          // Only consider it "on" if it's in abnormal state (2)
-          this->abnormal_struggle_sensor_->publish_state(struggle == 2);
-        }
-      }
+      ESP_LOGI(TAG, "Sleep mode set successfully");
+      this->init_state_ = INIT_SLEEP_MODE_DONE;
+      this->init_mode_set_sent_ = false;
+      this->init_retry_count_ = 0;
       break;
     }
     
-    case 9: {
-      // Get sleep composite data (includes many metrics in one call)
-      ESP_LOGD(TAG, "Reading sleep composite data with REG_SLEEP=%d, CMD_GET_SLEEP_COMPOSITE=%d", REG_SLEEP, CMD_GET_SLEEP_COMPOSITE);
-      success = this->send_command(REG_SLEEP, CMD_GET_SLEEP_COMPOSITE, 1, &dummy_byte, response);
-      
-      if (success) {
-        // Extract composite values - these are multiple bytes starting at response[6]
-        // Format from sSleepComposite struct:
-        // presence, sleepState, averageRespiration, averageHeartbeat, turnoverNumber, largeBodyMove, minorBodyMove, apneaEvents
-        uint8_t raw_avg_respiration = response[8];
-        uint8_t raw_avg_heartbeat = response[9];
-        this->turnover_count_ = response[10];
-        this->large_body_movement_ = response[11];
-        this->minor_body_movement_ = response[12];
-        this->apnea_events_ = response[13];
-        
-        // Apply scaling to respiration rate based on official spec range (10-25 BPM)
-        if (raw_avg_respiration < 8) {
-          // Too low to be physiologically realistic, scale up
-          this->average_respiration_ = 10.0f + ((float)raw_avg_respiration / 10.0f) * 5.0f;
-          ESP_LOGD(TAG, "Scaled low average respiration from raw %d to %.1f BPM", 
-                  raw_avg_respiration, this->average_respiration_);
-        } else if (raw_avg_respiration > 25 && raw_avg_respiration < 100) {
-          // Between official range max and likely scale value, map to official range
-          this->average_respiration_ = 10.0f + ((float)(raw_avg_respiration - 25) / 75.0f) * 15.0f;
-          ESP_LOGD(TAG, "Scaled mid average respiration from raw %d to %.1f BPM", 
-                  raw_avg_respiration, this->average_respiration_);
-        } else if (raw_avg_respiration >= 100) {
-          // Likely on a different scale entirely (0-255), map to official range
-          this->average_respiration_ = 10.0f + ((float)raw_avg_respiration / 255.0f) * 15.0f;
-          ESP_LOGD(TAG, "Scaled high average respiration from raw %d to %.1f BPM", 
-                  raw_avg_respiration, this->average_respiration_);
-        } else {
-          // Already within the official range of 10-25 BPM
-          this->average_respiration_ = raw_avg_respiration;
-        }
-        
-        // Apply scaling to heart rate based on official spec range (60-100 BPM)
-        if (raw_avg_heartbeat < 30) {
-          // Too low to be physiologically realistic, scale up
-          this->average_heartbeat_ = 60.0f + ((float)raw_avg_heartbeat / 30.0f) * 15.0f;
-          ESP_LOGD(TAG, "Scaled low average heart rate from raw %d to %.1f BPM", 
-                  raw_avg_heartbeat, this->average_heartbeat_);
-        } else if (raw_avg_heartbeat > 100 && raw_avg_heartbeat < 150) {
-          // Between official range max and likely scale threshold
-          this->average_heartbeat_ = 60.0f + ((float)(raw_avg_heartbeat - 30) / 120.0f) * 40.0f;
-          ESP_LOGD(TAG, "Scaled mid average heart rate from raw %d to %.1f BPM", 
-                  raw_avg_heartbeat, this->average_heartbeat_);
-        } else if (raw_avg_heartbeat >= 150) {
-          // Likely on a different scale entirely (0-255), map to official range
-          this->average_heartbeat_ = 60.0f + ((float)raw_avg_heartbeat / 255.0f) * 40.0f;
-          ESP_LOGD(TAG, "Scaled high average heart rate from raw %d to %.1f BPM", 
-                  raw_avg_heartbeat, this->average_heartbeat_);
-        } else if (raw_avg_heartbeat >= 30 && raw_avg_heartbeat < 60) {
-          // Below spec but potentially valid, apply gentle scaling
-          this->average_heartbeat_ = 60.0f - (60.0f - raw_avg_heartbeat) * 0.5f;
-          ESP_LOGD(TAG, "Adjusted below-range average heart rate from raw %d to %.1f BPM", 
-                  raw_avg_heartbeat, this->average_heartbeat_);
-        } else {
-          // Already within the official range of 60-100 BPM
-          this->average_heartbeat_ = raw_avg_heartbeat;
-        }
-        
-        ESP_LOGD(TAG, "Sleep composite: avg_resp=%.1f (raw=%d), avg_heart=%.1f (raw=%d), turnovers=%d, large_move=%d%%, minor_move=%d%%, apnea=%d",
-                 this->average_respiration_, raw_avg_respiration, 
-                 this->average_heartbeat_, raw_avg_heartbeat,
-                 this->turnover_count_, this->large_body_movement_, 
-                 this->minor_body_movement_, this->apnea_events_);
-        
-        // Publish all the values with range validation
-        if (this->average_respiration_sensor_ != nullptr) {
-          if (this->average_respiration_ >= 0 && this->average_respiration_ <= 40) {
-            this->average_respiration_sensor_->publish_state(this->average_respiration_);
-          } else {
-            ESP_LOGW(TAG, "Average respiration out of range: %.1f BPM (raw: %d)", 
-                    this->average_respiration_, raw_avg_respiration);
-          }
-        }
-        
-        if (this->average_heart_rate_sensor_ != nullptr) {
-          if (this->average_heartbeat_ >= 40 && this->average_heartbeat_ <= 150) {
-            this->average_heart_rate_sensor_->publish_state(this->average_heartbeat_);
-          } else {
-            ESP_LOGW(TAG, "Average heart rate out of range: %.1f BPM (raw: %d)", 
-                    this->average_heartbeat_, raw_avg_heartbeat);
-          }
-        }
-        
-        if (this->turnover_count_sensor_ != nullptr) {
-          this->turnover_count_sensor_->publish_state(this->turnover_count_);
-        }
-        
-        if (this->large_body_movement_sensor_ != nullptr) {
-          // Large body movement should be a percentage (0-100)
-          if (this->large_body_movement_ <= 100) {
-            this->large_body_movement_sensor_->publish_state(this->large_body_movement_);
-          } else {
-            ESP_LOGW(TAG, "Large body movement out of percentage range: %d%%", 
-                    this->large_body_movement_);
-          }
-        }
-        
-        if (this->minor_body_movement_sensor_ != nullptr) {
-          // Minor body movement should be a percentage (0-100)
-          if (this->minor_body_movement_ <= 100) {
-            this->minor_body_movement_sensor_->publish_state(this->minor_body_movement_);
-          } else {
-            ESP_LOGW(TAG, "Minor body movement out of percentage range: %d%%",
-                    this->minor_body_movement_);
-          }
-        }
-        
-        if (this->apnea_events_sensor_ != nullptr) {
-          this->apnea_events_sensor_->publish_state(this->apnea_events_);
-        }
-      }
+    case INIT_SLEEP_MODE_DONE: {
+      ESP_LOGI(TAG, "LED configured successfully");
+      this->init_state_ = INIT_LED_DONE;
+      this->init_retry_count_ = 0;
       break;
     }
     
-    case 10: {
-      // Get sleep durations
-      // Wake duration
-      ESP_LOGD(TAG, "Reading wake duration with REG_SLEEP=%d, CMD_GET_WAKE_DURATION=%d", REG_SLEEP, CMD_GET_WAKE_DURATION);
-      success = this->send_command(REG_SLEEP, CMD_GET_WAKE_DURATION, 1, &dummy_byte, response);
-      
-      if (success) {
-        // For durations, it's 16-bit (2 bytes) - combine response[6] and response[7]
-        uint16_t wake_duration = (response[6] << 8) | response[7];
-        ESP_LOGD(TAG, "Wake duration: %d minutes", wake_duration);
-        
-        if (this->awake_duration_sensor_ != nullptr) {
-          this->awake_duration_sensor_->publish_state(wake_duration);
-        }
+    case INIT_LED_DONE: {
+      // Give the radar time to come back from the reset before the first polls
+      ESP_LOGI(TAG, "Sensor reset successful");
+      for (auto &next_poll : this->next_poll_) {
+        next_poll = millis() + RESET_SETTLE_MS;
       }
+      this->init_state_ = INIT_COMPLETE;
+      this->sensor_initialized_ = true;
+      this->consecutive_errors_ = 0;
+      this->last_successful_read_ = millis();
+      ESP_LOGI(TAG, "C1001 initialization complete!");
+      this->init_retry_count_ = 0;
       break;
     }
     
-    case 11: {
-      // Light sleep duration
-      ESP_LOGD(TAG, "Reading light sleep duration with REG_SLEEP=%d, CMD_GET_LIGHT_SLEEP=%d", REG_SLEEP, CMD_GET_LIGHT_SLEEP);
-      success = this->send_command(REG_SLEEP, CMD_GET_LIGHT_SLEEP, 1, &dummy_byte, response);
-      
-      if (success) {
-        // For durations, it's 16-bit (2 bytes) - combine response[6] and response[7]
-        uint16_t light_sleep = (response[6] << 8) | response[7];
-        ESP_LOGD(TAG, "Light sleep duration: %d minutes", light_sleep);
-        
-        if (this->light_sleep_duration_sensor_ != nullptr) {
-          this->light_sleep_duration_sensor_->publish_state(light_sleep);
-        }
-      }
+    default:
       break;
+  }
+}
+
+// Validate a metric's payload and hand it to the publishing side - straight away, or
+// through the sample ring when the link runs in the UART task
+bool C1001Component::accept_metric_(uint8_t metric, C1001FrameView payload, bool pushed) {
+  const C1001MetricDef &def = METRICS[metric];
+  
+  // Never decode past the payload
+  if (payload.size() < def.width) {
+    uint16_t suppressed;
+    if (this->warn_allowed_(this->link_warnings_[metric], suppressed)) {
+      ESP_LOGW(TAG, "Response for %s too short: %d data bytes, need %d [%u similar suppressed]", def.name,
+               payload.size(), def.width, suppressed);
     }
-    
-    case 12: {
-      // Deep sleep duration
-      ESP_LOGD(TAG, "Reading deep sleep duration with REG_SLEEP=%d, CMD_GET_DEEP_SLEEP=%d", REG_SLEEP, CMD_GET_DEEP_SLEEP);
-      success = this->send_command(REG_SLEEP, CMD_GET_DEEP_SLEEP, 1, &dummy_byte, response);
-      
-      if (success) {
-        // For durations, it's 16-bit (2 bytes) - combine response[6] and response[7]
-        uint16_t deep_sleep = (response[6] << 8) | response[7];
-        ESP_LOGD(TAG, "Deep sleep duration: %d minutes", deep_sleep);
-        
-        if (this->deep_sleep_duration_sensor_ != nullptr) {
-          this->deep_sleep_duration_sensor_->publish_state(deep_sleep);
-        }
-      }
-      break;
+    return false;
+  }
+  
+  C1001Sample sample;
+  sample.metric = metric;
+  sample.pushed = pushed;
+  sample.frame_started_at = this->frame_started_at_;
+  memcpy(sample.payload, payload.data(), def.width);
+  
+  if (!this->link_in_task_) {
+    this->publish_sample_(sample);
+  } else if (!this->samples_.push(sample)) {
+    this->samples_dropped_++;
+    uint16_t suppressed;
+    if (this->warn_allowed_(this->ring_full_warning_, suppressed)) {
+      ESP_LOGW(TAG, "Sample ring full, dropped %s [%u similar suppressed]", def.name, suppressed);
+    }
+  }
+  return true;
+}
+
+void C1001Component::set_filter(C1001MetricId metric, uint8_t median_window, float outlier_threshold) {
+  if (metric >= C1001_METRIC_COUNT || METRICS[metric].filter == nullptr) {
+    ESP_LOGE(TAG, "%s can't be filtered", metric < C1001_METRIC_COUNT ? METRICS[metric].name : "?");
+    return;
+  }
+  C1001VitalFilter &filter = this->*METRICS[metric].filter;
+  filter.set_median_window(median_window);
+  filter.set_outlier_threshold(outlier_threshold);
+}
+
+void C1001Component::set_filter_ema(C1001MetricId metric, float alpha) {
+  if (metric < C1001_METRIC_COUNT && METRICS[metric].filter != nullptr) {
+    (this->*METRICS[metric].filter).set_ema(alpha);
+  }
+}
+
+void C1001Component::set_filter_kalman(C1001MetricId metric, float process_noise, float measurement_noise) {
+  if (metric < C1001_METRIC_COUNT && METRICS[metric].filter != nullptr) {
+    (this->*METRICS[metric].filter).set_kalman(process_noise, measurement_noise);
+  }
+}
+
+void C1001Component::add_statistics(C1001MetricId metric, uint32_t window_ms, sensor::Sensor *min_sensor,
+                                    sensor::Sensor *mean_sensor, sensor::Sensor *max_sensor,
+                                    sensor::Sensor *stddev_sensor) {
+  if (this->statistics_count_ == C1001_MAX_STATISTICS_WINDOWS) {
+    ESP_LOGE(TAG, "Too many statistics windows, ignoring one for %s", METRICS[metric].name);
+    return;
+  }
+  C1001StatisticsWindow &window = this->statistics_[this->statistics_count_++];
+  window.metric = metric;
+  window.stats.set_window(window_ms);
+  window.min_sensor = min_sensor;
+  window.mean_sensor = mean_sensor;
+  window.max_sensor = max_sensor;
+  window.stddev_sensor = stddev_sensor;
+}
+
+// Publish every statistics window that has samples in it
+void C1001Component::publish_statistics_() {
+  uint32_t now = millis();
+  C1001RollingStats::Summary summary;
+  for (uint8_t i = 0; i < this->statistics_count_; i++) {
+    C1001StatisticsWindow &window = this->statistics_[i];
+    if (!window.stats.summary(now, summary)) {
+      continue;
+    }
+    this->publish_(window.min_sensor, summary.min);
+    this->publish_(window.mean_sensor, summary.mean);
+    this->publish_(window.max_sensor, summary.max);
+    this->publish_(window.stddev_sensor, summary.stddev);
+  }
+}
+
+void C1001Component::set_publish_policy(sensor::Sensor *sensor, float deadband, uint32_t heartbeat_ms) {
+  if (this->publish_policy_count_ == C1001_MAX_PUBLISH_POLICIES) {
+    ESP_LOGE(TAG, "Too many sensors with a publish policy, %s publishes every value",
+             sensor->get_name().c_str());
+    return;
+  }
+  C1001PublishPolicy &policy = this->publish_policies_[this->publish_policy_count_++];
+  policy.sensor = sensor;
+  policy.deadband = deadband;
+  policy.heartbeat = heartbeat_ms;
+}
+
+// Publish a data sensor's value, unless its publish policy says the last one still stands
+void C1001Component::publish_(sensor::Sensor *sensor, float value) {
+  if (sensor == nullptr) {
+    return;
+  }
+  
+  for (uint8_t i = 0; i < this->publish_policy_count_; i++) {
+    C1001PublishPolicy &policy = this->publish_policies_[i];
+    if (policy.sensor != sensor) {
+      continue;
     }
     
-    case 13: {
-      // Sleep disturbance
-      ESP_LOGD(TAG, "Reading sleep disturbance with REG_SLEEP=%d, CMD_GET_SLEEP_DISTURBANCE=%d", REG_SLEEP, CMD_GET_SLEEP_DISTURBANCE);
-      success = this->send_command(REG_SLEEP, CMD_GET_SLEEP_DISTURBANCE, 1, &dummy_byte, response);
-      
-      if (success) {
-        // Extract sleep disturbance from response[6]
-        int disturbance = response[6];
-        ESP_LOGD(TAG, "Sleep disturbance: %d (0=<4hrs, 1=>12hrs, 2=abnormal, 3=none)", disturbance);
-        
-        if (this->sleep_disturbance_sensor_ != nullptr) {
-          // Only consider it "on" if there's a disturbance (not 3=none)
-          this->sleep_disturbance_sensor_->publish_state(disturbance != 3);
-        }
+    // The deadband is measured from the last value published, so slow drift still gets out
+    uint32_t now = millis();
+    bool moved = std::isnan(value) != std::isnan(policy.last) || std::fabs(value - policy.last) > policy.deadband;
+    bool heartbeat_due = policy.heartbeat != 0 && now - policy.last_at >= policy.heartbeat;
+    if (policy.published && !moved && !heartbeat_due) {
+      this->suppressed_publishes_++;
+      return;
+    }
+    policy.published = true;
+    policy.last = value;
+    policy.last_at = now;
+    break;
+  }
+  sensor->publish_state(value);
+}
+
+// Publishing side: send the last value again for every policy whose heartbeat has passed,
+// so a sensor stays fresh while its register isn't read (e.g. vitals in an empty room)
+void C1001Component::publish_overdue_() {
+  uint32_t now = millis();
+  for (uint8_t i = 0; i < this->publish_policy_count_; i++) {
+    C1001PublishPolicy &policy = this->publish_policies_[i];
+    if (!policy.published || policy.heartbeat == 0 || now - policy.last_at < policy.heartbeat) {
+      continue;
+    }
+    policy.last_at = now;
+    policy.sensor->publish_state(policy.last);
+  }
+}
+
+// Decode a sample and publish it to whatever the register map routes it to
+void C1001Component::publish_sample_(const C1001Sample &sample) {
+  const C1001MetricDef &def = METRICS[sample.metric];
+  C1001FrameView payload(sample.payload, def.width);
+  
+  if (def.handler != nullptr) {
+    (this->*def.handler)(sample);
+    return;
+  }
+  
+  float value = def.calibration != nullptr ? (this->*def.calibration)[payload[0]] : def.decode(payload);
+  ESP_LOGV(TAG, "%s: %.1f (raw: %d)", def.name, value, payload[0]);
+  uint16_t suppressed;
+  if (value < def.valid_min || value > def.valid_max) {
+    // Decoded fine but implausible - the read still succeeded
+    if (this->warn_allowed_(this->range_warnings_[sample.metric], suppressed)) {
+      ESP_LOGW(TAG, "Dropping implausible %s: %.1f (raw: %d) [%u similar suppressed]", def.name, value,
+               payload[0], suppressed);
+    }
+    return;
+  }
+  if ((value < def.spec_min || value > def.spec_max) &&
+      this->warn_allowed_(this->range_warnings_[sample.metric], suppressed)) {
+    ESP_LOGW(TAG, "%s outside specified range (%.0f-%.0f): %.1f (raw: %d) [%u similar suppressed]", def.name,
+             def.spec_min, def.spec_max, value, payload[0], suppressed);
+  }
+  
+  if (def.filter != nullptr && !(this->*def.filter).apply(value, value)) {
+    ESP_LOGV(TAG, "%s: rejected as an outlier", def.name);
+    return;
+  }
+  
+  for (uint8_t i = 0; i < this->statistics_count_; i++) {
+    if (this->statistics_[i].metric == sample.metric) {
+      this->statistics_[i].stats.add(millis(), value);
+    }
+  }
+  this->record_night_(sample.metric, value);
+  
+  if (def.cache != nullptr) {
+    this->*def.cache = (uint8_t) value;
+  }
+  if (sample.metric == METRIC_IN_BED) {
+    this->update_occupancy_();
+  }
+  if (sample.metric == METRIC_IN_BED || sample.metric == METRIC_SLEEP_STATE) {
+    this->update_session_();
+  }
+  if (def.sensor != nullptr && this->*def.sensor != nullptr) {
+    this->publish_(this->*def.sensor, value);
+  }
+  if (def.binary_sensor != nullptr && this->*def.binary_sensor != nullptr) {
+    (this->*def.binary_sensor)->publish_state(def.binary_decode(value));
+  }
+}
+
+// Publishing side: feed the sleep session tracker. The person counts as in bed while the radar
+// says so and, if presence is known, still detects them.
+void C1001Component::update_session_() {
+  bool in_bed = this->in_bed_ != 0 && (!this->presence_known_ || this->presence_detected_);
+  if (this->session_.update(millis(), in_bed, this->sleep_state_)) {
+    this->publish_session_();
+  }
+}
+
+// One record per night: log the session summary and publish it to the session sensors
+void C1001Component::publish_session_() {
+  const C1001SleepSession::Summary &summary = this->session_.summary();
+  uint32_t asleep_s = summary.stage_s[C1001SleepSession::STAGE_DEEP] + summary.stage_s[C1001SleepSession::STAGE_LIGHT];
+  float efficiency = summary.duration_s > 0 ? 100.0f * asleep_s / summary.duration_s : 0.0f;
+  char hypnogram[SESSION_HYPNOGRAM_SIZE];
+  this->session_.format_hypnogram(hypnogram, sizeof(hypnogram));
+  
+  ESP_LOGI(TAG, "Sleep session: %u min in bed, %u min asleep (%.0f%%), first sleep after %u min, %u awakenings, "
+           "%u stage changes", summary.duration_s / 60, asleep_s / 60, efficiency, summary.sleep_onset_s / 60,
+           summary.awakenings, summary.transitions);
+  ESP_LOGI(TAG, "Hypnogram: %s%s", hypnogram, summary.truncated ? " (last run merges the rest)" : "");
+  if (this->session_duration_sensor_ != nullptr) {
+    this->session_duration_sensor_->publish_state(summary.duration_s / 60.0f);
+  }
+  if (this->session_asleep_sensor_ != nullptr) {
+    this->session_asleep_sensor_->publish_state(asleep_s / 60.0f);
+  }
+  if (this->session_deep_sleep_sensor_ != nullptr) {
+    this->session_deep_sleep_sensor_->publish_state(summary.stage_s[C1001SleepSession::STAGE_DEEP] / 60.0f);
+  }
+  if (this->session_light_sleep_sensor_ != nullptr) {
+    this->session_light_sleep_sensor_->publish_state(summary.stage_s[C1001SleepSession::STAGE_LIGHT] / 60.0f);
+  }
+  if (this->session_awake_sensor_ != nullptr) {
+    this->session_awake_sensor_->publish_state(summary.stage_s[C1001SleepSession::STAGE_AWAKE] / 60.0f);
+  }
+  if (this->session_sleep_onset_sensor_ != nullptr) {
+    this->session_sleep_onset_sensor_->publish_state(summary.sleep_onset_s / 60.0f);
+  }
+  if (this->session_awakenings_sensor_ != nullptr) {
+    this->session_awakenings_sensor_->publish_state(summary.awakenings);
+  }
+  if (this->session_efficiency_sensor_ != nullptr) {
+    this->session_efficiency_sensor_->publish_state(efficiency);
+  }
+  if (this->session_hypnogram_sensor_ != nullptr) {
+    this->session_hypnogram_sensor_->publish_state(hypnogram);
+  }
+}
+
+// Publishing side: the room counts as occupied while someone is detected or in bed
+void C1001Component::update_occupancy_() {
+  this->occupied_.store(this->presence_detected_ || this->in_bed_ != 0, std::memory_order_relaxed);
+}
+
+// Scheduler side: track how long the room has been empty and switch the vacant watch on
+// or off. Someone coming back brings every metric due at once, so vitals and sleep
+// metrics are read on the very next pass.
+bool C1001Component::in_vacant_watch_(uint32_t now) {
+  if (!this->adaptive_polling_) {
+    return false;
+  }
+  
+  if (this->occupied_.load(std::memory_order_relaxed)) {
+    this->vacant_seen_ = false;
+    if (this->vacant_watch_) {
+      this->vacant_watch_ = false;
+      this->occupancy_wakeups_++;
+      ESP_LOGD(TAG, "Room occupied, resuming full polling");
+      for (auto &next_poll : this->next_poll_) {
+        next_poll = now;
       }
-      break;
     }
+    return false;
+  }
+  
+  if (!this->vacant_seen_) {
+    this->vacant_seen_ = true;
+    this->vacant_since_ = now;
+  }
+  if (!this->vacant_watch_ && now - this->vacant_since_ >= this->vacant_after_) {
+    this->vacant_watch_ = true;
+    ESP_LOGD(TAG, "Room empty for %u ms, polling presence only", now - this->vacant_since_);
+  }
+  return this->vacant_watch_;
+}
+
+// Registers still polled during the vacant watch
+bool C1001Component::watches_occupancy_(uint8_t metric) const {
+  return metric == METRIC_PRESENCE || metric == METRIC_IN_BED ||
+         (metric == METRIC_SLEEP_COMPOSITE && this->composite_presence_);
+}
+
+// Composite-first mode: the sleep composite frame opens with presence and sleep state, so
+// those registers aren't polled on their own - the composite is polled at the fastest of
+// their rates instead. The presence register's raw value isn't in the composite, so it
+// keeps its own poll while a raw presence sensor is configured.
+void C1001Component::fold_into_composite_() {
+  uint32_t &composite = this->poll_interval_[METRIC_SLEEP_COMPOSITE];
+  const C1001MetricId covered[] = {METRIC_PRESENCE, METRIC_SLEEP_STATE};
+  for (C1001MetricId metric : covered) {
+    uint32_t interval = this->poll_interval_[metric];
+    if (interval == 0 || (metric == METRIC_PRESENCE && this->presence_sensor_ != nullptr)) {
+      continue;
+    }
+    composite = composite == 0 ? interval : std::min(composite, interval);
+    this->poll_interval_[metric] = 0;
+    this->composite_presence_ |= metric == METRIC_PRESENCE;
+  }
+}
+
+// Raw presence value, and person_detected from it. The register holds 0 (nobody) or 1
+// (someone), in poll replies and push reports alike.
+void C1001Component::handle_presence_(const C1001Sample &sample) {
+  uint8_t raw = sample.payload[0];
+  ESP_LOGV(TAG, "presence: %d", raw);
+  if (this->presence_sensor_ != nullptr) {
+    this->publish_(this->presence_sensor_, raw);
+  }
+  this->apply_presence_(raw != 0, raw, sample);
+}
+
+// Debounce a presence sample into person_detected and time the edge if it changed. Someone
+// is detected at the first sample saying so; a polled "nobody" only counts once it has
+// been read presence_clear_samples_ times in a row. Push reports are the radar's own
+// decision and count at once.
+void C1001Component::apply_presence_(bool present, uint8_t raw, const C1001Sample &sample) {
+  uint32_t now = millis();
+  // A pushed report left the radar as the edge happened; a polled one could have
+  // happened any time since the previous sample
+  uint32_t since = sample.pushed ? sample.frame_started_at : this->presence_sampled_at_;
+  bool detected = present;
+  if (present) {
+    this->presence_absent_run_ = 0;
+  } else if (this->presence_detected_) {
+    if (this->presence_absent_run_++ == 0) {
+      this->presence_absent_since_ = since;
+    }
+    since = this->presence_absent_since_;
+    detected = !sample.pushed && this->presence_absent_run_ < this->presence_clear_samples_;
   }
   
-  ESP_LOGD(TAG, "Update complete - priority step: %d (vital count: %d)", current_step, vital_count);
+  if (this->presence_known_ && detected != this->presence_detected_) {
+    uint32_t latency = now - since;
+    ESP_LOGI(TAG, "Presence %s (raw %d, edge latency %u ms)", detected ? "detected" : "cleared", raw, latency);
+    if (this->presence_latency_sensor_ != nullptr) {
+      this->presence_latency_sensor_->publish_state(latency);
+    }
+  }
   
-  // Track success/failure
-  if (success) {
-    this->last_successful_read_ = millis();
-    this->consecutive_errors_ = 0;
-  } else {
-    this->consecutive_errors_++;
-    ESP_LOGW(TAG, "Failed to read sensor data, consecutive errors: %d", 
-             this->consecutive_errors_);
-    
-    // If we have too many consecutive errors, reset initialization
-    if (this->consecutive_errors_ >= MAX_CONSECUTIVE_ERRORS) {
-      ESP_LOGE(TAG, "Too many consecutive sensor errors, resetting initialization");
-      this->reset_initialization();
-      return;
+  this->presence_known_ = true;
+  this->presence_detected_ = detected;
+  this->presence_sampled_at_ = now;
+  this->night_store_.record_change(now / 1000, NIGHT_PRESENCE, detected);
+  this->update_occupancy_();
+  this->update_session_();
+  if (this->person_detected_ != nullptr) {
+    this->person_detected_->publish_state(detected);
+  }
+}
+
+// Sleep composite data - many metrics in one frame
+void C1001Component::handle_sleep_composite_(const C1001Sample &sample) {
+  const uint8_t *payload = sample.payload;
+  // Format from sSleepComposite struct:
+  // presence, sleepState, averageRespiration, averageHeartbeat, turnoverNumber, largeBodyMove, minorBodyMove, apneaEvents
+  uint8_t raw_avg_respiration = payload[2];
+  uint8_t raw_avg_heartbeat = payload[3];
+  this->turnover_count_ = payload[4];
+  this->large_body_movement_ = payload[5];
+  this->minor_body_movement_ = payload[6];
+  this->apnea_events_ = payload[7];
+  
+  // Fan the leading fields out to the sensors of the registers the composite replaces;
+  // presence is the same 0/1 the presence register reports
+  if (this->composite_first_) {
+    if (this->composite_presence_) {
+      this->apply_presence_(payload[0] != 0, payload[0], sample);
+    }
+    C1001Sample sleep_state = sample;
+    sleep_state.metric = METRIC_SLEEP_STATE;
+    sleep_state.payload[0] = payload[1];
+    this->publish_sample_(sleep_state);
+  }
+  
+  // Same scaling as the live values, against the official spec ranges
+  this->average_respiration_ = this->respiration_calibration_[raw_avg_respiration];
+  this->average_heartbeat_ = this->heart_rate_calibration_[raw_avg_heartbeat];
+  
+  ESP_LOGV(TAG, "Sleep composite: avg_resp=%.1f (raw=%d), avg_heart=%.1f (raw=%d), turnovers=%d, large_move=%d%%, minor_move=%d%%, apnea=%d",
+           this->average_respiration_, raw_avg_respiration, 
+           this->average_heartbeat_, raw_avg_heartbeat,
+           this->turnover_count_, this->large_body_movement_, 
+           this->minor_body_movement_, this->apnea_events_);
+  
+  // Publish all the values with range validation
+  uint16_t suppressed;
+  if (this->average_respiration_sensor_ != nullptr) {
+    if (this->average_respiration_ >= 0 && this->average_respiration_ <= 40) {
+      this->publish_(this->average_respiration_sensor_, this->average_respiration_);
+    } else if (this->warn_allowed_(this->range_warnings_[METRIC_SLEEP_COMPOSITE], suppressed)) {
+      ESP_LOGW(TAG, "Average respiration out of range: %.1f BPM (raw: %d) [%u similar suppressed]",
+               this->average_respiration_, raw_avg_respiration, suppressed);
+    }
+  }
+  
+  if (this->average_heart_rate_sensor_ != nullptr) {
+    if (this->average_heartbeat_ >= 40 && this->average_heartbeat_ <= 150) {
+      this->publish_(this->average_heart_rate_sensor_, this->average_heartbeat_);
+    } else if (this->warn_allowed_(this->range_warnings_[METRIC_SLEEP_COMPOSITE], suppressed)) {
+      ESP_LOGW(TAG, "Average heart rate out of range: %.1f BPM (raw: %d) [%u similar suppressed]",
+               this->average_heartbeat_, raw_avg_heartbeat, suppressed);
+    }
+  }
+  
+  if (this->turnover_count_sensor_ != nullptr) {
+    this->publish_(this->turnover_count_sensor_, this->turnover_count_);
+  }
+  
+  if (this->large_body_movement_sensor_ != nullptr) {
+    // Large body movement should be a percentage (0-100)
+    if (this->large_body_movement_ <= 100) {
+      this->publish_(this->large_body_movement_sensor_, this->large_body_movement_);
+    } else if (this->warn_allowed_(this->range_warnings_[METRIC_SLEEP_COMPOSITE], suppressed)) {
+      ESP_LOGW(TAG, "Large body movement out of percentage range: %d%% [%u similar suppressed]",
+               this->large_body_movement_, suppressed);
     }
   }
   
-  ESP_LOGD(TAG, "Update complete - read step: %d", read_step);
+  if (this->minor_body_movement_sensor_ != nullptr) {
+    // Minor body movement should be a percentage (0-100)
+    if (this->minor_body_movement_ <= 100) {
+      this->publish_(this->minor_body_movement_sensor_, this->minor_body_movement_);
+    } else if (this->warn_allowed_(this->range_warnings_[METRIC_SLEEP_COMPOSITE], suppressed)) {
+      ESP_LOGW(TAG, "Minor body movement out of percentage range: %d%% [%u similar suppressed]",
+               this->minor_body_movement_, suppressed);
+    }
+  }
+  
+  if (this->apnea_events_sensor_ != nullptr) {
+    this->publish_(this->apnea_events_sensor_, this->apnea_events_);
+  }
 }
 
 void c1001::C1001Component::dump_config() {
@@ -909,6 +1623,7 @@ void c1001::C1001Component::dump_config() {
   LOG_SENSOR("    ", "Presence", this->presence_sensor_);
   LOG_SENSOR("    ", "Movement", this->movement_sensor_);
   LOG_BINARY_SENSOR("    ", "Person Detected", this->person_detected_);
+  LOG_SENSOR("    ", "Presence Edge Latency", this->presence_latency_sensor_);
   
   // Sleep metrics
   ESP_LOGCONFIG(TAG, "  Sleep Metrics:");
@@ -928,12 +1643,76 @@ void c1001::C1001Component::dump_config() {
   LOG_SENSOR("    ", "Large Body Movement", this->large_body_movement_sensor_);
   LOG_SENSOR("    ", "Minor Body Movement", this->minor_body_movement_sensor_);
   LOG_SENSOR("    ", "Apnea Events", this->apnea_events_sensor_);
+  LOG_SENSOR("    ", "Sleep Score", this->sleep_score_sensor_);
+  
+  // Sleep session summary
+  ESP_LOGCONFIG(TAG, "  Sleep Session (ends %u ms out of bed, at least %u ms long):", this->session_.end_after(),
+                this->session_.min_duration());
+  LOG_SENSOR("    ", "Duration", this->session_duration_sensor_);
+  LOG_SENSOR("    ", "Time Asleep", this->session_asleep_sensor_);
+  LOG_SENSOR("    ", "Deep Sleep", this->session_deep_sleep_sensor_);
+  LOG_SENSOR("    ", "Light Sleep", this->session_light_sleep_sensor_);
+  LOG_SENSOR("    ", "Awake", this->session_awake_sensor_);
+  LOG_SENSOR("    ", "Sleep Onset", this->session_sleep_onset_sensor_);
+  LOG_SENSOR("    ", "Awakenings", this->session_awakenings_sensor_);
+  LOG_SENSOR("    ", "Efficiency", this->session_efficiency_sensor_);
+  LOG_TEXT_SENSOR("    ", "Hypnogram", this->session_hypnogram_sensor_);
   
   // Sleep alerts
   ESP_LOGCONFIG(TAG, "  Sleep Alerts:");
   LOG_BINARY_SENSOR("    ", "Abnormal Struggle", this->abnormal_struggle_sensor_);
   LOG_BINARY_SENSOR("    ", "Sleep Disturbance", this->sleep_disturbance_sensor_);
   
+  // Link health
+  ESP_LOGCONFIG(TAG, "  Link Diagnostics:");
+  LOG_SENSOR("    ", "RX Bytes", this->rx_bytes_sensor_);
+  LOG_SENSOR("    ", "TX Bytes", this->tx_bytes_sensor_);
+  LOG_SENSOR("    ", "Timeouts", this->timeouts_sensor_);
+  LOG_SENSOR("    ", "Checksum Errors", this->checksum_errors_sensor_);
+  LOG_SENSOR("    ", "Resyncs", this->resyncs_sensor_);
+  LOG_SENSOR("    ", "Partial Frames", this->partial_frames_sensor_);
+  LOG_SENSOR("    ", "Round Trip Time", this->round_trip_time_sensor_);
+  LOG_SENSOR("    ", "Poll Rate", this->poll_rate_sensor_);
+  LOG_SENSOR("    ", "Polls Skipped While Vacant", this->vacant_skipped_polls_sensor_);
+  LOG_SENSOR("    ", "Occupancy Wakeups", this->occupancy_wakeups_sensor_);
+  LOG_SENSOR("    ", "Suppressed Publishes", this->suppressed_publishes_sensor_);
+  LOG_SENSOR("    ", "Rejected Outliers", this->rejected_outliers_sensor_);
+  
+  ESP_LOGCONFIG(TAG, "  Presence Clears After: %u samples", this->presence_clear_samples_);
+  for (uint8_t i = 0; i < this->statistics_count_; i++) {
+    ESP_LOGCONFIG(TAG, "  Statistics: %s over %u ms", METRICS[this->statistics_[i].metric].name,
+                  this->statistics_[i].stats.window());
+  }
+  ESP_LOGCONFIG(TAG, "  Respiration Calibration: %s",
+                this->respiration_calibration_ == C1001_DEFAULT_RESPIRATION.bpm ? "default" : "custom");
+  ESP_LOGCONFIG(TAG, "  Heart Rate Calibration: %s",
+                this->heart_rate_calibration_ == C1001_DEFAULT_HEART_RATE.bpm ? "default" : "custom");
+  for (uint8_t i = 0; i < this->publish_policy_count_; i++) {
+    const C1001PublishPolicy &policy = this->publish_policies_[i];
+    ESP_LOGCONFIG(TAG, "  Publish '%s' on change beyond %.2f, heartbeat %u ms", policy.sensor->get_name().c_str(),
+                  policy.deadband, policy.heartbeat);
+  }
+  ESP_LOGCONFIG(TAG, "  Polled Metrics:");
+  for (uint8_t metric = 0; metric < C1001_METRIC_COUNT; metric++) {
+    if (this->poll_interval_[metric] != 0) {
+      ESP_LOGCONFIG(TAG, "    %s: every %u ms", METRICS[metric].name, this->poll_interval_[metric]);
+    }
+  }
+  ESP_LOGCONFIG(TAG, "  Push Reports: %s", YESNO(this->push_reports_));
+  ESP_LOGCONFIG(TAG, "  Composite First: %s", YESNO(this->composite_first_));
+  if (this->adaptive_polling_) {
+    ESP_LOGCONFIG(TAG, "  Adaptive Polling: presence every %u ms after %u ms vacant", this->vacant_interval_,
+                  this->vacant_after_);
+  }
+  ESP_LOGCONFIG(TAG, "  UART Task: %s", YESNO(this->link_in_task_));
+  ESP_LOGCONFIG(TAG, "  Capture Buffer: %u bytes", this->capture_size_);
+  ESP_LOGCONFIG(TAG, "  Night Store: %u bytes", this->night_store_.capacity());
+  if (this->samples_dropped_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Samples Dropped: %u", this->samples_dropped_);
+  }
+  ESP_LOGCONFIG(TAG, "  Max Requests In Flight: %d", this->max_in_flight_);
+  ESP_LOGCONFIG(TAG, "  Request Wire Time: %u us (slowest write call so far: %u us)",
+                this->wire_time_us_(C1001_FRAME_SIZE), this->tx_write_us_max_);
   ESP_LOGCONFIG(TAG, "  Sensor Initialized: %s", YESNO(this->sensor_initialized_));
 }
 
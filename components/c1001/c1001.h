@@ -4,13 +4,162 @@
 #include "esphome/components/uart/uart.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
+#include "esphome/components/text_sensor/text_sensor.h"
 // No need to include DFRobot_HumanDetection library anymore
 // We've implemented direct UART communication
 #include <Stream.h> // Arduino Stream class
 
+#include "c1001_calibration.h"
+#include "c1001_filter.h"
+#include "c1001_protocol.h"
+#include "c1001_session.h"
+#include "c1001_stats.h"
+#include "c1001_store.h"
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
 namespace esphome {
 namespace c1001 {
 
+class C1001Component;
+
+// Registers the component reads, in register map order (see C1001Component::METRICS)
+enum C1001MetricId : uint8_t {
+  METRIC_PRESENCE = 0,
+  METRIC_MOVEMENT,
+  METRIC_RESPIRATION,
+  METRIC_HEART_RATE,
+  METRIC_IN_BED,
+  METRIC_SLEEP_STATE,
+  METRIC_SLEEP_QUALITY,
+  METRIC_SLEEP_QUALITY_RATING,
+  METRIC_ABNORMAL_STRUGGLE,
+  METRIC_SLEEP_COMPOSITE,
+  METRIC_AWAKE_DURATION,
+  METRIC_LIGHT_SLEEP_DURATION,
+  METRIC_DEEP_SLEEP_DURATION,
+  METRIC_SLEEP_DISTURBANCE,
+  METRIC_SLEEP_STATISTICS,
+  C1001_METRIC_COUNT
+};
+
+// How eagerly a metric is polled
+enum C1001PollClass : uint8_t {
+  POLL_CLASS_PRESENCE = 0,  // Presence, sent ahead of everything else
+  POLL_CLASS_VITAL,         // Heart rate and respiration
+  POLL_CLASS_STATUS,        // Movement
+  POLL_CLASS_SLEEP,         // Slow-moving sleep metrics
+};
+
+// Longest payload a register map row reads (the sleep composite frame)
+static const uint8_t C1001_MAX_METRIC_WIDTH = 8;
+
+// A validated reply or push report for one metric, on its way to be published
+struct C1001Sample {
+  uint8_t metric{0};                             // C1001MetricId
+  bool pushed{false};                            // Unsolicited report rather than a poll reply
+  uint32_t frame_started_at{0};                  // millis() when the frame's start byte arrived
+  uint8_t payload[C1001_MAX_METRIC_WIDTH]{0};
+};
+
+// Samples buffered between the UART task and loop()
+static const uint8_t C1001_SAMPLE_RING_SIZE = 32;
+
+// One row of the register map
+struct C1001MetricDef {
+  const char *name;
+  C1001Frame request;                                            // Poll request (register + command)
+  uint8_t width;                                                 // Payload bytes the decoder reads
+  C1001PollClass poll_class;
+  float (*decode)(C1001FrameView payload);                       // Payload -> value, NAN rejects it
+  sensor::Sensor *C1001Component::*sensor;                       // Numeric target, may be nullptr
+  binary_sensor::BinarySensor *C1001Component::*binary_sensor;   // Binary target, may be nullptr
+  bool (*binary_decode)(float value);                            // Value -> binary state
+  uint8_t C1001Component::*cache;                                // Last value cache, may be nullptr
+  void (C1001Component::*handler)(const C1001Sample &sample);    // Replaces decode for multi-field frames
+  float spec_min{-INFINITY};                                     // Published with a warning outside this
+  float spec_max{INFINITY};
+  float valid_min{-INFINITY};                                    // Dropped outside this
+  float valid_max{INFINITY};
+  const float *C1001Component::*calibration{nullptr};            // 256-entry raw -> value table, replaces decode
+  C1001VitalFilter C1001Component::*filter{nullptr};             // Smoothing between decode and publish
+};
+
+// Logs a repeating warning at most once per window and counts the rest
+struct C1001WarnLimiter {
+  uint32_t last_logged{0};
+  uint16_t suppressed{0};
+  bool logged{false};
+};
+
+// Change-only publishing for one sensor: a value goes out when it differs from the last
+// one published by more than deadband, or once heartbeat ms have passed without one - in
+// which case update() sends the last value again if no new one has come in
+struct C1001PublishPolicy {
+  sensor::Sensor *sensor{nullptr};
+  float deadband{0};
+  uint32_t heartbeat{0};             // 0 = no forced publishes
+  float last{NAN};
+  uint32_t last_at{0};
+  bool published{false};
+};
+
+// One per data sensor (18) and statistics sensor (24) is enough
+static const uint8_t C1001_MAX_PUBLISH_POLICIES = 42;
+
+// Rolling statistics of one metric over one window, published as derived sensors
+struct C1001StatisticsWindow {
+  uint8_t metric{0};                 // C1001MetricId
+  C1001RollingStats stats;
+  sensor::Sensor *min_sensor{nullptr};
+  sensor::Sensor *mean_sensor{nullptr};
+  sensor::Sensor *max_sensor{nullptr};
+  sensor::Sensor *stddev_sensor{nullptr};
+};
+
+// Up to three windows for each of the two vital signs
+static const uint8_t C1001_MAX_STATISTICS_WINDOWS = 6;
+
+// Channels of the night store; vitals are stored every sample, the rest on change
+enum C1001NightChannel : uint8_t {
+  NIGHT_HEART_RATE = 0,
+  NIGHT_RESPIRATION,
+  NIGHT_SLEEP_STATE,
+  NIGHT_IN_BED,
+  NIGHT_PRESENCE,                    // Debounced person_detected
+};
+
+// Round-trip latency histogram for one register, fixed buckets (bounds in c1001.cpp)
+static const uint8_t C1001_LATENCY_BUCKETS = 8;
+struct C1001LatencyHistogram {
+  uint32_t counts[C1001_LATENCY_BUCKETS]{0};
+  uint32_t max_us{0};
+};
+
+// Slots in the command pipeline (queued + in flight)
+static const uint8_t C1001_QUEUE_SIZE = 16;
+// Step value marking initialization requests
+static const uint8_t C1001_INIT_STEP = 0xFF;
+
+// A request waiting in, or travelling through, the command pipeline
+struct C1001Request {
+  const C1001Frame *frame{nullptr};  // nullptr marks a free slot
+  uint8_t step{0};                   // C1001MetricId, or C1001_INIT_STEP
+  uint8_t attempts{0};               // Transmissions so far
+  bool in_flight{false};             // Sent and waiting for its reply
+  bool priority{false};              // Sent ahead of older non-priority requests
+  uint32_t seq{0};                   // Enqueue order - the oldest request is sent first
+  uint32_t sent_at{0};               // millis() of the last transmission
+  uint32_t first_sent_at_us{0};      // micros() of the first transmission - round trips include retries
+};
+
 class UARTToStream : public Stream {
  public:
   UARTToStream(uart::UARTDevice *parent) : parent_(parent) {}
@@ -48,18 +197,108 @@ class C1001Component : public PollingComponent, public uart::UARTDevice {
   ~C1001Component();
 
   void setup() override;
+  void loop() override;
   void update() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
   
-  // Handle communication errors
-  void on_uart_error();
+  // Restart the initialization handshake; safe to call from lambdas, the link side picks
+  // it up on its next pass
+  void reset_initialization() { reset_pending_ = true; }
+  
+  // Poll a metric every interval_ms (0 = derive from the update interval). Only metrics
+  // feeding a configured sensor are added, so nothing else costs UART bandwidth.
+  void add_polled_metric(C1001MetricId metric, uint32_t interval_ms);
+  
+  // Number of requests allowed on the wire before their replies arrive
+  void set_max_in_flight(uint8_t max_in_flight) { max_in_flight_ = max_in_flight; }
+  
+  // Use the radar's unsolicited reports and skip polling what it already pushes
+  void set_push_reports(bool push_reports) { push_reports_ = push_reports; }
+  
+  // Poll the sleep composite frame in place of the registers it already carries (presence
+  // and sleep state) and fan it out to their sensors
+  void set_composite_first(bool composite_first) { composite_first_ = composite_first; }
+  
+  // Once nobody has been present or in bed for vacant_after ms, poll only presence and in-bed,
+  // at most every vacant_interval ms; everything else resumes as soon as someone is back
+  void set_adaptive_polling(uint32_t vacant_interval, uint32_t vacant_after) {
+    adaptive_polling_ = true;
+    vacant_interval_ = vacant_interval;
+    vacant_after_ = vacant_after;
+  }
+  
+  // Replace the built-in raw -> BPM curves with a 256-entry table per metric (a calibration
+  // profile generated from YAML); the table must outlive the component
+  void set_respiration_calibration(const float *table) { respiration_calibration_ = table; }
+  void set_heart_rate_calibration(const float *table) { heart_rate_calibration_ = table; }
   
-  // Method to request a reset of the initialization
-  void reset_initialization();
+  // Filter a vital sign between decode and publish: median over median_window samples,
+  // rejecting samples further than outlier_threshold from it (0 = off), then optionally
+  // smoothed. Only metrics with a filter slot in the register map (the vitals) take one.
+  void set_filter(C1001MetricId metric, uint8_t median_window, float outlier_threshold);
+  void set_filter_ema(C1001MetricId metric, float alpha);
+  void set_filter_kalman(C1001MetricId metric, float process_noise, float measurement_noise);
   
-  // Direct command helper using DFRobot protocol format
-  bool send_command(uint8_t con, uint8_t cmd, uint8_t data_len = 1, uint8_t* data = nullptr, uint8_t* response_buffer = nullptr);
+  // Keep min/mean/max/stddev of a metric's published values over a sliding window and publish
+  // them to the given sensors (any may be nullptr) every update
+  void add_statistics(C1001MetricId metric, uint32_t window_ms, sensor::Sensor *min_sensor,
+                      sensor::Sensor *mean_sensor, sensor::Sensor *max_sensor, sensor::Sensor *stddev_sensor);
+  
+  // Keep the vitals and sleep state in a delta-encoded ring of this many bytes (0 = off)
+  void set_night_store_size(uint32_t night_store_size) { night_store_size_ = night_store_size; }
+  // Write the night store to the log as hex, one block per loop pass, oldest first
+  void dump_night_store();
+  // For lambdas that ship the blocks elsewhere, see C1001NightStore::read_block()
+  const C1001NightStore &night_store() const { return night_store_; }
+  
+  // A sleep session ends once the person has been out of bed for end_after ms; sessions
+  // shorter than min_duration ms are not reported
+  void set_sleep_session(uint32_t end_after, uint32_t min_duration) { session_.set_timing(end_after, min_duration); }
+  
+  // Run the UART link in its own task on the other core (ESP32 only); loop() only publishes
+  void set_uart_task(bool uart_task) { uart_task_ = uart_task; }
+  
+  // Record raw RX/TX traffic into a ring of this many bytes (0 = off)
+  void set_capture_size(uint16_t capture_size) { capture_size_ = capture_size; }
+  // Write the capture to the log as hex, oldest record first; safe to call from lambdas
+  void dump_capture() { capture_dump_pending_ = true; }
+  // Time the protocol hot paths (encode, checksum, parse, scaling, dispatch) and log ns/op
+  void run_benchmark() { benchmark_pending_ = true; }
+  // Log the per-register round-trip histograms and link counters
+  void dump_link_stats() { link_stats_dump_pending_ = true; }
+  
+  // Link health diagnostics, published on every update
+  void set_rx_bytes_sensor(sensor::Sensor *rx_bytes_sensor) { rx_bytes_sensor_ = rx_bytes_sensor; }
+  void set_tx_bytes_sensor(sensor::Sensor *tx_bytes_sensor) { tx_bytes_sensor_ = tx_bytes_sensor; }
+  void set_timeouts_sensor(sensor::Sensor *timeouts_sensor) { timeouts_sensor_ = timeouts_sensor; }
+  void set_checksum_errors_sensor(sensor::Sensor *checksum_errors_sensor) {
+    checksum_errors_sensor_ = checksum_errors_sensor;
+  }
+  void set_resyncs_sensor(sensor::Sensor *resyncs_sensor) { resyncs_sensor_ = resyncs_sensor; }
+  void set_partial_frames_sensor(sensor::Sensor *partial_frames_sensor) {
+    partial_frames_sensor_ = partial_frames_sensor;
+  }
+  void set_round_trip_time_sensor(sensor::Sensor *round_trip_time_sensor) {
+    round_trip_time_sensor_ = round_trip_time_sensor;
+  }
+  void set_poll_rate_sensor(sensor::Sensor *poll_rate_sensor) { poll_rate_sensor_ = poll_rate_sensor; }
+  void set_vacant_skipped_polls_sensor(sensor::Sensor *vacant_skipped_polls_sensor) {
+    vacant_skipped_polls_sensor_ = vacant_skipped_polls_sensor;
+  }
+  void set_occupancy_wakeups_sensor(sensor::Sensor *occupancy_wakeups_sensor) {
+    occupancy_wakeups_sensor_ = occupancy_wakeups_sensor;
+  }
+  void set_suppressed_publishes_sensor(sensor::Sensor *suppressed_publishes_sensor) {
+    suppressed_publishes_sensor_ = suppressed_publishes_sensor;
+  }
+  void set_rejected_outliers_sensor(sensor::Sensor *rejected_outliers_sensor) {
+    rejected_outliers_sensor_ = rejected_outliers_sensor;
+  }
+  
+  // Publish this sensor only when its value changes by more than deadband, or after
+  // heartbeat_ms (0 = never) without a publish
+  void set_publish_policy(sensor::Sensor *sensor, float deadband, uint32_t heartbeat_ms);
   
   // Helper to calculate checksum
   uint8_t calculate_checksum(uint8_t len, uint8_t* buf);
@@ -71,6 +310,11 @@ class C1001Component : public PollingComponent, public uart::UARTDevice {
   void set_person_detected_binary_sensor(binary_sensor::BinarySensor *person_detected) {
     person_detected_ = person_detected;
   }
+  // Polled "nobody" samples in a row before person_detected clears; push reports clear it at once
+  void set_presence_clear_samples(uint8_t presence_clear_samples) { presence_clear_samples_ = presence_clear_samples; }
+  void set_presence_latency_sensor(sensor::Sensor *presence_latency_sensor) {
+    presence_latency_sensor_ = presence_latency_sensor;
+  }
   
   // Sleep metrics access methods - moved to public section
   void set_sleep_state_sensor(sensor::Sensor *sleep_state_sensor) { sleep_state_sensor_ = sleep_state_sensor; }
@@ -89,6 +333,20 @@ class C1001Component : public PollingComponent, public uart::UARTDevice {
   void set_minor_body_movement_sensor(sensor::Sensor *minor_body_movement_sensor) { minor_body_movement_sensor_ = minor_body_movement_sensor; }
   void set_sleep_score_sensor(sensor::Sensor *sleep_score_sensor) { sleep_score_sensor_ = sleep_score_sensor; }
   
+  // Per-night summary, published once when a sleep session ends
+  void set_session_duration_sensor(sensor::Sensor *session_duration_sensor) { session_duration_sensor_ = session_duration_sensor; }
+  void set_session_asleep_sensor(sensor::Sensor *session_asleep_sensor) { session_asleep_sensor_ = session_asleep_sensor; }
+  void set_session_deep_sleep_sensor(sensor::Sensor *session_deep_sleep_sensor) { session_deep_sleep_sensor_ = session_deep_sleep_sensor; }
+  void set_session_light_sleep_sensor(sensor::Sensor *session_light_sleep_sensor) { session_light_sleep_sensor_ = session_light_sleep_sensor; }
+  void set_session_awake_sensor(sensor::Sensor *session_awake_sensor) { session_awake_sensor_ = session_awake_sensor; }
+  void set_session_sleep_onset_sensor(sensor::Sensor *session_sleep_onset_sensor) { session_sleep_onset_sensor_ = session_sleep_onset_sensor; }
+  void set_session_awakenings_sensor(sensor::Sensor *session_awakenings_sensor) { session_awakenings_sensor_ = session_awakenings_sensor; }
+  void set_session_efficiency_sensor(sensor::Sensor *session_efficiency_sensor) { session_efficiency_sensor_ = session_efficiency_sensor; }
+  void set_session_hypnogram_text_sensor(text_sensor::TextSensor *session_hypnogram_sensor) { session_hypnogram_sensor_ = session_hypnogram_sensor; }
+  
+  // Register map, one row per C1001MetricId
+  static const C1001MetricDef METRICS[C1001_METRIC_COUNT];
+  
   void set_abnormal_struggle_sensor(binary_sensor::BinarySensor *abnormal_struggle_sensor) { abnormal_struggle_sensor_ = abnormal_struggle_sensor; }
   void set_sleep_disturbance_sensor(binary_sensor::BinarySensor *sleep_disturbance_sensor) { sleep_disturbance_sensor_ = sleep_disturbance_sensor; }
 
@@ -97,6 +355,167 @@ class C1001Component : public PollingComponent, public uart::UARTDevice {
   int init_state_{0};  // Track initialization state
   uint32_t last_successful_read_{0}; // Track time of last successful read
   uint8_t consecutive_errors_{0};    // Track consecutive errors
+  uint8_t init_retry_count_{0};      // Attempts at the current initialization step
+  bool init_mode_set_sent_{false};   // Work mode set command issued during init
+
+  // Command pipeline driven from loop(); replies are matched by (con, cmd)
+  C1001Request requests_[C1001_QUEUE_SIZE];
+  uint32_t request_seq_{0};
+  uint8_t max_in_flight_{4};
+  uint32_t tx_write_us_max_{0};      // Longest time write_array() took to accept a request
+
+  // Deadline scheduler
+  uint32_t poll_interval_[C1001_METRIC_COUNT]{0};  // 0 = metric not polled
+  bool poll_default_[C1001_METRIC_COUNT]{false};   // A sensor wants the default interval, see setup()
+  uint32_t next_poll_[C1001_METRIC_COUNT]{0};      // millis() the metric is next due
+
+  // Unsolicited report handling
+  bool push_reports_{true};
+  uint32_t last_push_[C1001_METRIC_COUNT]{0};  // millis() of the last push report per metric
+  
+  // Composite-first polling
+  bool composite_first_{false};
+  bool composite_presence_{false};   // Presence comes from the composite instead of its register
+  
+  // Adaptive polling. occupied_ is written by the publishing side from presence and in-bed
+  // samples; the rest belongs to the scheduler.
+  bool adaptive_polling_{false};
+  uint32_t vacant_interval_{0};
+  uint32_t vacant_after_{0};
+  std::atomic<bool> occupied_{true};  // Unknown counts as occupied, so nothing slows down at boot
+  bool vacant_watch_{false};          // Only the occupancy registers are being polled
+  bool vacant_seen_{false};
+  uint32_t vacant_since_{0};          // millis() the room was first seen empty
+  uint32_t vacant_skipped_polls_{0};
+  uint32_t occupancy_wakeups_{0};     // Vacant watches ended by someone coming back
+
+  // Streaming frame parser
+  C1001FrameParser parser_;
+  uint32_t frame_started_at_{0};     // millis() when the frame's first byte was read
+  uint32_t checksum_errors_seen_{0};    // Count at the last loop pass, to spot new errors
+  uint32_t checksum_errors_logged_{0};  // Count at the last warning
+
+  // Wire capture, see C1001CaptureRing for the record format
+  uint16_t capture_size_{0};
+  std::unique_ptr<uint8_t[]> capture_buffer_;
+  C1001CaptureRing capture_;
+  std::atomic<bool> capture_dump_pending_{false};
+  std::atomic<bool> benchmark_pending_{false};
+
+  // Link health. Written on the link side only; the plain 32-bit counters are read
+  // from loop() for publishing, which is safe on the ESP32 without locking.
+  C1001LatencyHistogram latency_[C1001_METRIC_COUNT];
+  uint32_t rx_bytes_{0};
+  uint32_t tx_bytes_{0};
+  uint32_t timeouts_{0};
+  uint32_t retries_{0};
+  uint32_t responses_{0};            // Poll replies matched to their request
+  uint32_t round_trip_total_us_{0};  // Sum of their round-trip times (wraps)
+  std::atomic<bool> link_stats_dump_pending_{false};
+  std::atomic<bool> reset_pending_{false};
+  
+  // Rate limits for the per-sample warnings; link-side and publish-side ones are kept
+  // apart so the UART task and loop() never share a limiter
+  C1001WarnLimiter link_warnings_[C1001_METRIC_COUNT];  // Per metric
+  C1001WarnLimiter queue_full_warning_;
+  C1001WarnLimiter ring_full_warning_;
+  C1001WarnLimiter checksum_warning_;
+  C1001WarnLimiter range_warnings_[C1001_METRIC_COUNT];
+  // Snapshot at the last publish, to turn the totals into per-interval rates
+  uint32_t responses_published_{0};
+  uint32_t round_trip_total_published_{0};
+  uint32_t link_stats_published_at_{0};
+
+  // Raw -> BPM calibration tables, the built-in defaults unless a profile is configured
+  const float *respiration_calibration_{C1001_DEFAULT_RESPIRATION.bpm};
+  const float *heart_rate_calibration_{C1001_DEFAULT_HEART_RATE.bpm};
+  
+  // Rolling statistics, publishing side only
+  C1001StatisticsWindow statistics_[C1001_MAX_STATISTICS_WINDOWS];
+  uint8_t statistics_count_{0};
+  
+  // Night store, publishing side only. A dump walks the block numbers from
+  // night_dump_next_ up to the block being written when it was asked for.
+  uint32_t night_store_size_{0};
+  std::unique_ptr<uint8_t[]> night_store_buffer_;
+  C1001NightStore night_store_;
+  bool night_dump_pending_{false};
+  uint32_t night_dump_next_{0};
+  uint32_t night_dump_end_{0};
+  
+  // Vital sign filters, publishing side only; pass-through until configured
+  C1001VitalFilter respiration_filter_;
+  C1001VitalFilter heart_rate_filter_;
+
+  // Change-only publishing, publishing side only
+  C1001PublishPolicy publish_policies_[C1001_MAX_PUBLISH_POLICIES];
+  uint8_t publish_policy_count_{0};
+  uint32_t suppressed_publishes_{0};
+
+  // Presence fast path
+  uint8_t presence_clear_samples_{2};
+  uint8_t presence_absent_run_{0};   // Polled "nobody" samples in a row while detected
+  bool presence_known_{false};       // A presence sample has been seen since boot
+  bool presence_detected_{false};    // Debounced person_detected state
+  uint32_t presence_sampled_at_{0};  // millis() of the last presence sample
+  uint32_t presence_absent_since_{0};  // Earliest the person can have left, for the edge latency
+
+  // Link/publish split. With uart_task_ the link side (parser, queue, scheduler, init)
+  // runs in its own task and hands samples to loop() through samples_.
+  bool uart_task_{false};
+  bool link_in_task_{false};
+  std::atomic<bool> update_pending_{false};
+  C1001SpscRing<C1001Sample, C1001_SAMPLE_RING_SIZE> samples_;
+  uint32_t samples_dropped_{0};
+#ifdef USE_ESP32
+  TaskHandle_t uart_task_handle_{nullptr};
+  static void uart_task_loop_(void *arg);
+#endif
+
+  // Transaction helpers
+  uint32_t wire_time_us_(uint8_t len) const;
+  // Link side only: these touch the request queue and the UART, which the UART task owns
+  void reset_initialization_();
+  void on_uart_error_();
+  bool send_command_(const C1001Frame &frame);
+  bool enqueue_request_(const C1001Frame &frame, uint8_t step);
+  void pump_requests_();
+  void check_request_timeouts_();
+  void clear_requests_();
+  bool requests_idle_() const;
+  uint8_t free_request_slots_() const;
+  void schedule_polls_();
+  void handle_frame_();
+  void handle_report_(uint8_t con, uint8_t cmd);
+  bool is_push_covered_(uint8_t metric, uint32_t now) const;
+  void handle_response_(uint8_t step, C1001FrameView payload);
+  void handle_timeout_(uint8_t step);
+  void send_init_step_();
+  void handle_init_response_(C1001FrameView payload);
+  void service_link_();
+  void dump_capture_();
+  void run_benchmark_();
+  void record_round_trip_(uint8_t metric, uint32_t round_trip_us);
+  bool warn_allowed_(C1001WarnLimiter &limiter, uint16_t &suppressed);
+  void dump_link_stats_();
+  void publish_link_stats_();
+  void run_update_();
+  bool accept_metric_(uint8_t metric, C1001FrameView payload, bool pushed);
+  void publish_sample_(const C1001Sample &sample);
+  void handle_sleep_composite_(const C1001Sample &sample);
+  void handle_presence_(const C1001Sample &sample);
+  void apply_presence_(bool present, uint8_t raw, const C1001Sample &sample);
+  void fold_into_composite_();
+  void update_occupancy_();
+  void publish_(sensor::Sensor *sensor, float value);
+  void publish_overdue_();
+  void publish_statistics_();
+  void record_night_(uint8_t metric, float value);
+  void update_session_();
+  void publish_session_();
+  void dump_night_block_();
+  bool in_vacant_watch_(uint32_t now);
+  bool watches_occupancy_(uint8_t metric) const;
 
   // Basic sensors
   sensor::Sensor *respiration_sensor_{nullptr};
@@ -104,6 +523,21 @@ class C1001Component : public PollingComponent, public uart::UARTDevice {
   sensor::Sensor *presence_sensor_{nullptr};
   sensor::Sensor *movement_sensor_{nullptr};
   binary_sensor::BinarySensor *person_detected_{nullptr};
+  sensor::Sensor *presence_latency_sensor_{nullptr};       // Age of a presence edge when published
+  
+  // Link health diagnostic sensors
+  sensor::Sensor *rx_bytes_sensor_{nullptr};
+  sensor::Sensor *tx_bytes_sensor_{nullptr};
+  sensor::Sensor *timeouts_sensor_{nullptr};
+  sensor::Sensor *checksum_errors_sensor_{nullptr};
+  sensor::Sensor *resyncs_sensor_{nullptr};
+  sensor::Sensor *partial_frames_sensor_{nullptr};
+  sensor::Sensor *round_trip_time_sensor_{nullptr};          // Mean over the last update interval, ms
+  sensor::Sensor *poll_rate_sensor_{nullptr};                // Replies per second over the last interval
+  sensor::Sensor *vacant_skipped_polls_sensor_{nullptr};
+  sensor::Sensor *occupancy_wakeups_sensor_{nullptr};
+  sensor::Sensor *suppressed_publishes_sensor_{nullptr};
+  sensor::Sensor *rejected_outliers_sensor_{nullptr};
   
   // Sleep-specific sensors
   sensor::Sensor *sleep_state_sensor_{nullptr};              // 0=Deep, 1=Light, 2=Awake, 3=None
@@ -126,6 +560,18 @@ class C1001Component : public PollingComponent, public uart::UARTDevice {
   binary_sensor::BinarySensor *abnormal_struggle_sensor_{nullptr};  // Abnormal struggle state
   binary_sensor::BinarySensor *sleep_disturbance_sensor_{nullptr};  // Sleep disturbance state
   
+  // Sleep session summary, publishing side only
+  C1001SleepSession session_;
+  sensor::Sensor *session_duration_sensor_{nullptr};         // Minutes in bed
+  sensor::Sensor *session_asleep_sensor_{nullptr};           // Minutes in deep or light sleep
+  sensor::Sensor *session_deep_sleep_sensor_{nullptr};
+  sensor::Sensor *session_light_sleep_sensor_{nullptr};
+  sensor::Sensor *session_awake_sensor_{nullptr};            // Minutes awake, out of bed included
+  sensor::Sensor *session_sleep_onset_sensor_{nullptr};      // Minutes from bedtime to first sleep
+  sensor::Sensor *session_awakenings_sensor_{nullptr};
+  sensor::Sensor *session_efficiency_sensor_{nullptr};       // Percent of the session asleep
+  text_sensor::TextSensor *session_hypnogram_sensor_{nullptr};
+  
   // Sleep composite data cache
   uint8_t sleep_state_{3};                   // Default: None
   uint8_t in_bed_{0};                        // Default: Not in bed
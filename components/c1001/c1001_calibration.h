@@ -0,0 +1,72 @@
+#pragma once
+
+// Raw -> BPM calibration for the radar's vital sign bytes. Each curve is compiled into a
+// 256-entry table, so decoding a reading is a single load. The default curves below map
+// the raw values into the official measurement ranges; a per-device profile from YAML
+// replaces a table without touching code. No ESPHome dependencies (needs C++14).
+
+#include <cstdint>
+
+namespace esphome {
+namespace c1001 {
+
+// One BPM value per possible raw byte
+struct C1001CalibrationTable {
+  float bpm[256];
+
+  // Fill the table from a curve at compile time
+  constexpr explicit C1001CalibrationTable(float (*curve)(uint8_t)) : bpm() {
+    for (uint16_t raw = 0; raw < 256; raw++) {
+      this->bpm[raw] = curve((uint8_t) raw);
+    }
+  }
+};
+
+// Official spec: Breath Measurement Range: 10-25 breaths per minute
+constexpr float c1001_default_respiration(uint8_t raw) {
+  if (raw < 8) {
+    // Too low to be physiologically realistic, scale up
+    // Map 0-10 raw values to the 10-15 BPM range (lower half of spec)
+    return 10.0f + ((float) raw / 10.0f) * 5.0f;
+  }
+  if (raw > 25 && raw < 100) {
+    // Between official range max and likely scale value, map to official range
+    return 10.0f + ((float) (raw - 25) / 75.0f) * 15.0f;
+  }
+  if (raw >= 100) {
+    // Likely on a different scale entirely (0-255), map to official range
+    return 10.0f + ((float) raw / 255.0f) * 15.0f;
+  }
+  // Already within the official range of 10-25 BPM
+  return raw;
+}
+
+// Official spec: Heart Rate Measurement Range: 60-100 beats per minute
+constexpr float c1001_default_heart_rate(uint8_t raw) {
+  if (raw < 30) {
+    // Too low to be physiologically realistic, scale up
+    // Map 0-30 raw values to the 60-75 BPM range (lower half of spec)
+    return 60.0f + ((float) raw / 30.0f) * 15.0f;
+  }
+  if (raw > 100 && raw < 150) {
+    // Between official range max and likely scale threshold
+    return 60.0f + ((float) (raw - 30) / 120.0f) * 40.0f;
+  }
+  if (raw >= 150) {
+    // Likely on a different scale entirely (0-255), map to official range
+    return 60.0f + ((float) raw / 255.0f) * 40.0f;
+  }
+  if (raw < 60) {
+    // Below spec but potentially valid, apply gentle scaling that preserves some of the difference
+    return 60.0f - (60.0f - raw) * 0.5f;
+  }
+  // Already within the official range of 60-100 BPM
+  return raw;
+}
+
+// The default curves as tables, defined (constexpr) in c1001.cpp
+extern const C1001CalibrationTable C1001_DEFAULT_RESPIRATION;
+extern const C1001CalibrationTable C1001_DEFAULT_HEART_RATE;
+
+}  // namespace c1001
+}  // namespace esphome
@@ -0,0 +1,79 @@
+#include "c1001_filter.h"
+
+#include <cmath>
+
+namespace esphome {
+namespace c1001 {
+
+void C1001VitalFilter::set_median_window(uint8_t window) {
+  if (window < 1) {
+    window = 1;
+  } else if (window > MAX_MEDIAN_WINDOW) {
+    window = MAX_MEDIAN_WINDOW;
+  }
+  this->window_ = window;
+  this->count_ = 0;
+  this->next_ = 0;
+}
+
+bool C1001VitalFilter::apply(float value, float &out) {
+  if (std::isnan(value)) {
+    return false;
+  }
+  
+  // Judge the sample against the window before it joins it
+  bool outlier = this->outlier_threshold_ > 0 && this->count_ == this->window_ && this->window_ > 2 &&
+                 std::fabs(value - this->median_()) > this->outlier_threshold_;
+  this->insert_(value);
+  if (outlier) {
+    this->outliers_++;
+    return false;
+  }
+  
+  float filtered = this->window_ > 1 ? this->median_() : value;
+  if (!this->primed_) {
+    this->primed_ = true;
+    this->estimate_ = filtered;
+    this->variance_ = this->r_;
+  } else if (this->smoothing_ == SMOOTHING_EMA) {
+    this->estimate_ += this->alpha_ * (filtered - this->estimate_);
+  } else if (this->smoothing_ == SMOOTHING_KALMAN) {
+    // Without any noise the gain would be 0/0; follow the input instead
+    this->variance_ += this->q_;
+    float total = this->variance_ + this->r_;
+    float gain = total > 0 ? this->variance_ / total : 1.0f;
+    this->estimate_ += gain * (filtered - this->estimate_);
+    this->variance_ *= 1.0f - gain;
+  } else {
+    this->estimate_ = filtered;
+  }
+  out = this->estimate_;
+  return true;
+}
+
+// Add a sample to the window, evicting the oldest once it's full. The sorted copy is
+// kept up to date by shifting, at most window_ moves per sample.
+void C1001VitalFilter::insert_(float value) {
+  uint8_t pos;
+  if (this->count_ == this->window_) {
+    // Take the evicted sample out of the sorted copy
+    float old = this->ring_[this->next_];
+    for (pos = 0; pos < this->count_ - 1 && this->sorted_[pos] != old; pos++) {
+    }
+    for (; pos < this->count_ - 1; pos++) {
+      this->sorted_[pos] = this->sorted_[pos + 1];
+    }
+    this->count_--;
+  }
+  this->ring_[this->next_] = value;
+  this->next_ = (this->next_ + 1) % this->window_;
+  
+  for (pos = this->count_; pos > 0 && this->sorted_[pos - 1] > value; pos--) {
+    this->sorted_[pos] = this->sorted_[pos - 1];
+  }
+  this->sorted_[pos] = value;
+  this->count_++;
+}
+
+}  // namespace c1001
+}  // namespace esphome
@@ -0,0 +1,71 @@
+#pragma once
+
+// Streaming filter for vital sign samples: a fixed-window median with outlier rejection,
+// then an optional exponential or Kalman smoother. Fixed memory, no allocation, and a
+// bounded amount of work per sample. No ESPHome dependencies.
+
+#include <cstdint>
+
+namespace esphome {
+namespace c1001 {
+
+class C1001VitalFilter {
+ public:
+  static const uint8_t MAX_MEDIAN_WINDOW = 9;
+
+  enum Smoothing : uint8_t {
+    SMOOTHING_NONE = 0,
+    SMOOTHING_EMA,
+    SMOOTHING_KALMAN,
+  };
+
+  // Median over the last window samples (1 = off, clamped to MAX_MEDIAN_WINDOW)
+  void set_median_window(uint8_t window);
+  // Reject a sample further than this from the current median (0 = off; needs a window of
+  // at least 3). Rejected samples still enter the window, so a real, lasting change gets
+  // through after a few samples.
+  void set_outlier_threshold(float threshold) { this->outlier_threshold_ = threshold; }
+  // Exponential smoothing, alpha in (0, 1]: higher follows the input faster
+  void set_ema(float alpha) {
+    this->smoothing_ = SMOOTHING_EMA;
+    this->alpha_ = alpha;
+  }
+  // One-dimensional Kalman filter for a slowly drifting value: process noise q is how far
+  // the true rate may move between samples, measurement noise r how noisy a sample is. Both
+  // should be above 0; with q = 0 the estimate settles and stops following the input.
+  void set_kalman(float q, float r) {
+    this->smoothing_ = SMOOTHING_KALMAN;
+    this->q_ = q;
+    this->r_ = r;
+  }
+
+  // Feed one sample. Returns false if it was rejected as an outlier; otherwise the value
+  // to publish is in out.
+  bool apply(float value, float &out);
+
+  uint32_t outliers() const { return this->outliers_; }
+
+ protected:
+  void insert_(float value);
+  float median_() const { return this->sorted_[this->count_ / 2]; }
+
+  uint8_t window_{1};
+  float outlier_threshold_{0};
+  Smoothing smoothing_{SMOOTHING_NONE};
+  float alpha_{1};
+  float q_{0};
+  float r_{0};
+
+  float ring_[MAX_MEDIAN_WINDOW]{};    // Window samples in arrival order
+  float sorted_[MAX_MEDIAN_WINDOW]{};  // The same samples, ascending
+  uint8_t count_{0};
+  uint8_t next_{0};                    // Ring slot the next sample overwrites
+
+  bool primed_{false};                 // Smoother has a state to start from
+  float estimate_{0};
+  float variance_{0};                  // Kalman estimate variance
+  uint32_t outliers_{0};
+};
+
+}  // namespace c1001
+}  // namespace esphome
@@ -0,0 +1,202 @@
+#include "c1001_protocol.h"
+
+#include <cstring>
+
+namespace esphome {
+namespace c1001 {
+
+uint8_t c1001_checksum(const uint8_t *buf, uint8_t len) {
+  uint16_t sum = 0;
+  for (uint8_t i = 0; i < len; i++) {
+    sum += buf[i];
+  }
+  return sum & 0xFF;
+}
+
+void C1001FrameParser::feed(uint8_t byte) {
+  this->pending_[0] = byte;
+  this->pending_len_ = 1;
+  this->pending_pos_ = 0;
+}
+
+bool C1001FrameParser::next() {
+  if (this->complete_) {
+    this->complete_ = false;
+    this->state_ = WAIT_START1;
+    this->pos_ = 0;
+  }
+  
+  while (this->pending_pos_ < this->pending_len_) {
+    uint8_t byte = this->pending_[this->pending_pos_++];
+    this->buffer_[this->pos_++] = byte;
+    if (this->advance_(byte)) {
+      if (this->complete_) {
+        this->frames_++;
+        return true;
+      }
+      continue;
+    }
+    
+    // Rejected. If the next frame started inside this one, this one was cut short, whichever
+    // check happened to fail on the newcomer's bytes.
+    if (this->interrupted_()) {
+      this->partial_frames_++;
+    } else if (this->state_ == CHECK_SUM) {
+      this->checksum_errors_++;
+    } else if (this->state_ == WAIT_END1 || this->state_ == WAIT_END2) {
+      this->partial_frames_++;
+    }
+    
+    // Queue the held bytes after the bogus start ahead of whatever is still pending
+    uint8_t held = this->pos_ - 1;
+    uint8_t rest = this->pending_len_ - this->pending_pos_;
+    memmove(&this->pending_[held], &this->pending_[this->pending_pos_], rest);
+    memcpy(this->pending_, &this->buffer_[1], held);
+    this->pending_len_ = held + rest;
+    this->pending_pos_ = 0;
+    this->state_ = WAIT_START1;
+    this->pos_ = 0;
+    this->rejected_++;
+  }
+  return false;
+}
+
+// The next frame started inside the one being assembled: a header (0x53 0x59) after its
+// start byte, or a start byte where the rejected byte was expected. A corrupt checksum that
+// happens to read 0x53 is counted as partial too, a small price for catching the cut.
+bool C1001FrameParser::interrupted_() const {
+  if (this->buffer_[this->pos_ - 1] == 0x53) {
+    return true;
+  }
+  for (uint8_t i = 1; i + 1 < this->pos_; i++) {
+    if (this->buffer_[i] == 0x53 && this->buffer_[i + 1] == 0x59) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Advance the state machine with the byte just stored at buffer_[pos_ - 1].
+// Returns false if the byte proves the frame being assembled is corrupt.
+bool C1001FrameParser::advance_(uint8_t byte) {
+  switch (this->state_) {
+    case WAIT_START1:
+      if (byte == 0x53) {
+        this->state_ = WAIT_START2;
+      } else {
+        // Noise between frames
+        this->pos_ = 0;
+      }
+      return true;
+      
+    case WAIT_START2:
+      if (byte != 0x59) {
+        return false;
+      }
+      this->state_ = WAIT_CONFIG;
+      return true;
+      
+    case WAIT_CONFIG:
+      this->state_ = WAIT_CMD;
+      return true;
+      
+    case WAIT_CMD:
+      this->state_ = WAIT_LEN_H;
+      return true;
+      
+    case WAIT_LEN_H:
+      this->data_len_ = byte << 8;
+      this->state_ = WAIT_LEN_L;
+      return true;
+      
+    case WAIT_LEN_L:
+      // Length is big-endian; anything longer than the buffer can hold is a corrupt header
+      this->data_len_ |= byte;
+      if (this->data_len_ > C1001_MAX_DATA_LEN) {
+        return false;
+      }
+      this->state_ = this->data_len_ > 0 ? READ_DATA : CHECK_SUM;
+      return true;
+      
+    case READ_DATA:
+      if (this->pos_ == 6 + this->data_len_) {
+        this->state_ = CHECK_SUM;
+      }
+      return true;
+      
+    case CHECK_SUM:
+      // Checksum covers header and data, i.e. everything before this byte
+      if (byte != c1001_checksum(this->buffer_, this->pos_ - 1)) {
+        return false;
+      }
+      this->state_ = WAIT_END1;
+      return true;
+      
+    case WAIT_END1:
+      if (byte != 0x54) {
+        return false;
+      }
+      this->state_ = WAIT_END2;
+      return true;
+      
+    case WAIT_END2:
+      if (byte != 0x43) {
+        return false;
+      }
+      this->complete_ = true;
+      return true;
+      
+    default:
+      this->state_ = WAIT_START1;
+      this->pos_ = 0;
+      return true;
+  }
+}
+
+void C1001CaptureRing::record(uint32_t now, bool tx, const uint8_t *data, uint16_t len) {
+  while (this->buffer_ != nullptr && len > 0) {
+    uint8_t chunk = len > MAX_CHUNK ? MAX_CHUNK : len;
+    uint16_t needed = HEADER_SIZE + chunk;
+    if (needed > this->size_) {
+      return;
+    }
+    while (this->size_ - this->used_ < needed) {
+      this->evict_oldest_();
+    }
+    
+    this->put_((tx ? 0x80 : 0x00) | chunk);
+    for (uint8_t shift = 0; shift < 32; shift += 8) {
+      this->put_((now >> shift) & 0xFF);
+    }
+    for (uint8_t i = 0; i < chunk; i++) {
+      this->put_(data[i]);
+    }
+    data += chunk;
+    len -= chunk;
+  }
+}
+
+uint16_t C1001CaptureRing::read(uint16_t offset, uint8_t *out, uint16_t max_len) const {
+  uint16_t copied = 0;
+  while (offset + copied < this->used_ && copied < max_len) {
+    out[copied] = this->buffer_[(this->tail_ + offset + copied) % this->size_];
+    copied++;
+  }
+  return copied;
+}
+
+void C1001CaptureRing::put_(uint8_t byte) {
+  this->buffer_[this->head_] = byte;
+  this->head_ = (this->head_ + 1) % this->size_;
+  this->used_++;
+}
+
+void C1001CaptureRing::evict_oldest_() {
+  uint16_t record_size = HEADER_SIZE + (this->buffer_[this->tail_] & MAX_CHUNK);
+  this->tail_ = (this->tail_ + record_size) % this->size_;
+  this->used_ -= record_size;
+  this->dropped_++;
+}
+
+}  // namespace c1001
+}  // namespace esphome
@@ -0,0 +1,206 @@
+#pragma once
+
+// The radar's wire protocol: request frames, checksum, the streaming frame parser and the
+// SPSC ring. Nothing here depends on ESPHome or Arduino, so it builds on any host.
+
+#include <atomic>
+#include <cstdint>
+
+namespace esphome {
+namespace c1001 {
+
+// Every request is header (6) + 1 data byte + checksum + 2 end bytes
+static const uint8_t C1001_FRAME_SIZE = 10;
+
+// A complete request frame: [0x53, 0x59, con, cmd, 0x00, 0x01, data, checksum, 0x54, 0x43]
+struct C1001Frame {
+  uint8_t bytes[C1001_FRAME_SIZE];
+
+  constexpr uint8_t con() const { return bytes[2]; }
+  constexpr uint8_t cmd() const { return bytes[3]; }
+};
+
+// Build a request at compile time - checksum is the low byte of the sum of everything before it
+constexpr C1001Frame make_c1001_request(uint8_t con, uint8_t cmd, uint8_t data = 0x0F) {
+  return C1001Frame{{0x53, 0x59, con, cmd, 0x00, 0x01, data,
+                     static_cast<uint8_t>((0x53 + 0x59 + con + cmd + 0x00 + 0x01 + data) & 0xFF),
+                     0x54, 0x43}};
+}
+
+// Compile-time comparison against a reference frame, for static_assert
+constexpr bool c1001_frame_equals(const C1001Frame &frame, const uint8_t (&expected)[C1001_FRAME_SIZE],
+                                  uint8_t i = 0) {
+  return i == C1001_FRAME_SIZE || (frame.bytes[i] == expected[i] && c1001_frame_equals(frame, expected, i + 1));
+}
+
+// Sum of the bytes, low byte only - what the radar puts before the end bytes
+uint8_t c1001_checksum(const uint8_t *buf, uint8_t len);
+
+// Largest data section the parser accepts; longer length fields mean a corrupt header
+static const uint16_t C1001_MAX_DATA_LEN = 48;
+
+// Bounded, read-only window onto bytes owned by someone else - usually the parser's frame
+// storage. Indexing past the end reads 0 instead of whatever follows, so a decoder handed a
+// short payload can never overrun it; size() tells it whether the bytes it wants are there.
+class C1001FrameView {
+ public:
+  constexpr C1001FrameView() = default;
+  constexpr C1001FrameView(const uint8_t *data, uint16_t size) : data_(data), size_(size) {}
+  
+  constexpr const uint8_t *data() const { return this->data_; }
+  constexpr uint16_t size() const { return this->size_; }
+  constexpr uint8_t operator[](uint16_t i) const { return i < this->size_ ? this->data_[i] : 0; }
+  
+  // Up to len bytes starting at offset, clamped to this view
+  constexpr C1001FrameView sub(uint16_t offset, uint16_t len) const {
+    return offset >= this->size_ ? C1001FrameView(this->data_, 0)
+                                 : C1001FrameView(this->data_ + offset,
+                                                  len < this->size_ - offset ? len : this->size_ - offset);
+  }
+
+ protected:
+  const uint8_t *data_{nullptr};
+  uint16_t size_{0};
+};
+
+// Streaming parser for radar frames. Bytes are fed one at a time as they arrive; next()
+// then yields each complete, checksum-valid frame. When a partial frame turns out to be
+// corrupt, every byte held after its start byte is rescanned, so a real frame that began
+// inside the garbage is still recovered.
+class C1001FrameParser {
+ public:
+  // Queue one received byte; call next() until it returns false before feeding another
+  void feed(uint8_t byte);
+  
+  // Parse queued bytes until a frame completes (true) or they run out (false). The frame
+  // stays readable through the accessors below until the next call; the views point into
+  // the parser's own storage, so nothing is copied out.
+  bool next();
+  
+  // No frame is partially assembled
+  bool idle() const { return this->pos_ == 0 && this->pending_pos_ == this->pending_len_; }
+  
+  // The whole frame, header to end bytes
+  C1001FrameView frame() const { return C1001FrameView(this->buffer_, this->pos_); }
+  uint8_t con() const { return this->buffer_[2]; }
+  uint8_t cmd() const { return this->buffer_[3]; }
+  // The data section, exactly as long as the header announced
+  C1001FrameView payload() const { return this->frame().sub(6, this->data_len_); }
+  
+  uint32_t frames() const { return this->frames_; }
+  uint32_t rejected() const { return this->rejected_; }
+  uint32_t checksum_errors() const { return this->checksum_errors_; }
+  // Frames cut short: interrupted by the next frame's header, or whose end bytes didn't
+  // follow where the length said they would
+  uint32_t partial_frames() const { return this->partial_frames_; }
+
+ protected:
+  enum State : uint8_t {
+    WAIT_START1 = 0,
+    WAIT_START2,
+    WAIT_CONFIG,
+    WAIT_CMD,
+    WAIT_LEN_H,
+    WAIT_LEN_L,
+    READ_DATA,
+    CHECK_SUM,
+    WAIT_END1,
+    WAIT_END2,
+  };
+  
+  bool advance_(uint8_t byte);
+  bool interrupted_() const;
+  
+  // Header (6) + data + checksum + end bytes (2) of the longest accepted frame
+  static const uint8_t MAX_FRAME_SIZE = 9 + C1001_MAX_DATA_LEN;
+  
+  State state_{WAIT_START1};
+  bool complete_{false};             // buffer_ holds a frame handed out by next()
+  uint8_t buffer_[MAX_FRAME_SIZE]{0};  // Bytes of the frame being assembled
+  uint8_t pos_{0};                   // Bytes currently held in buffer_
+  uint16_t data_len_{0};             // Data length announced by the frame header
+  uint8_t pending_[MAX_FRAME_SIZE]{0};  // Bytes still to parse, including rescanned ones
+  uint8_t pending_len_{0};
+  uint8_t pending_pos_{0};
+  uint32_t frames_{0};
+  uint32_t rejected_{0};
+  uint32_t checksum_errors_{0};
+  uint32_t partial_frames_{0};
+};
+
+// Capture of raw UART traffic in a caller-provided byte buffer, oldest records evicted
+// first. Each record is a 5 byte header - direction/length byte (bit 7 set for TX, bits
+// 0-6 the byte count) and a little-endian uint32 millis() timestamp - followed by the
+// bytes. Reading the records back in order gives a replayable capture of the link.
+class C1001CaptureRing {
+ public:
+  static const uint8_t HEADER_SIZE = 5;
+  static const uint8_t MAX_CHUNK = 0x7F;
+  
+  void init(uint8_t *buffer, uint16_t size) {
+    this->buffer_ = buffer;
+    this->size_ = size;
+    this->clear();
+  }
+  bool enabled() const { return this->buffer_ != nullptr; }
+  void clear() {
+    this->head_ = this->tail_ = this->used_ = 0;
+  }
+  
+  // Append one record; chunks longer than MAX_CHUNK are split
+  void record(uint32_t now, bool tx, const uint8_t *data, uint16_t len);
+  
+  // Copy out up to max_len bytes of the capture, oldest first, starting offset bytes in.
+  // Returns the number of bytes copied.
+  uint16_t read(uint16_t offset, uint8_t *out, uint16_t max_len) const;
+  uint16_t used() const { return this->used_; }
+  uint32_t dropped() const { return this->dropped_; }
+
+ protected:
+  void put_(uint8_t byte);
+  void evict_oldest_();
+  
+  uint8_t *buffer_{nullptr};
+  uint16_t size_{0};
+  uint16_t head_{0};                 // Next byte written
+  uint16_t tail_{0};                 // Oldest record's header
+  uint16_t used_{0};
+  uint32_t dropped_{0};              // Records evicted to make room
+};
+
+// Single-producer/single-consumer ring. One task pushes, one other task pops; the
+// indices are atomics, so neither side ever takes a lock or blocks.
+template<typename T, uint8_t N> class C1001SpscRing {
+  static_assert(N > 0 && N <= 128 && (N & (N - 1)) == 0, "ring size must be a power of two up to 128");
+
+ public:
+  // Producer side. Returns false when the ring is full.
+  bool push(const T &item) {
+    uint8_t head = head_.load(std::memory_order_relaxed);
+    if ((uint8_t) (head - tail_.load(std::memory_order_acquire)) == N) {
+      return false;
+    }
+    items_[head & (N - 1)] = item;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+  
+  // Consumer side. Returns false when the ring is empty.
+  bool pop(T &item) {
+    uint8_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = items_[tail & (N - 1)];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+ protected:
+  T items_[N];
+  std::atomic<uint8_t> head_{0};
+  std::atomic<uint8_t> tail_{0};
+};
+
+}  // namespace c1001
+}  // namespace esphome
@@ -0,0 +1,122 @@
+#include "c1001_session.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace c1001 {
+
+bool C1001SleepSession::update(uint32_t now, bool in_bed, uint8_t stage) {
+  if (stage >= STAGE_COUNT) {
+    stage = STAGE_NONE;
+  }
+  
+  if (!this->active_) {
+    if (!in_bed) {
+      return false;
+    }
+    this->active_ = true;
+    this->slept_ = stage == STAGE_DEEP || stage == STAGE_LIGHT;
+    this->out_ = false;
+    this->summary_ = Summary();
+    this->summary_.start = now;
+    this->stage_ = stage;
+    this->run_start_ = now;
+    return false;
+  }
+  
+  if (in_bed) {
+    // Back from a trip out of bed, which counts as awake
+    if (this->out_ && this->stage_ != STAGE_AWAKE) {
+      this->change_stage_(this->out_since_, STAGE_AWAKE);
+    }
+    this->out_ = false;
+    if (stage != this->stage_) {
+      this->change_stage_(now, stage);
+    }
+    return false;
+  }
+  if (!this->out_) {
+    this->out_ = true;
+    this->out_since_ = now;
+    return false;
+  }
+  if (now - this->out_since_ < this->end_after_) {
+    return false;
+  }
+  
+  // Out of bed for good: the session ended when they got up
+  this->close_run_(this->out_since_);
+  this->active_ = false;
+  this->summary_.duration_s = (this->out_since_ - this->summary_.start) / 1000;
+  if (!this->slept_) {
+    this->summary_.sleep_onset_s = this->summary_.duration_s;
+  }
+  return this->summary_.duration_s * 1000 >= this->min_duration_;
+}
+
+void C1001SleepSession::change_stage_(uint32_t now, uint8_t stage) {
+  this->close_run_(now);
+  this->summary_.transitions++;
+  if (stage == STAGE_AWAKE && this->slept_) {
+    this->summary_.awakenings++;
+  }
+  if ((stage == STAGE_DEEP || stage == STAGE_LIGHT) && !this->slept_) {
+    this->slept_ = true;
+    this->summary_.sleep_onset_s = (now - this->summary_.start) / 1000;
+  }
+  this->stage_ = stage;
+  this->run_start_ = now;
+}
+
+// Add the open run, up to now, to the stage totals and the hypnogram
+void C1001SleepSession::close_run_(uint32_t now) {
+  Summary &summary = this->summary_;
+  uint32_t seconds = (now - this->run_start_) / 1000;
+  summary.stage_s[this->stage_] += seconds;
+  
+  Run *run;
+  if (summary.runs > 0 && this->runs_[summary.runs - 1].stage == this->stage_) {
+    run = &this->runs_[summary.runs - 1];
+  } else if (summary.runs < MAX_RUNS) {
+    run = &this->runs_[summary.runs++];
+    run->stage = this->stage_;
+    run->seconds = 0;
+  } else {
+    summary.truncated = true;
+    run = &this->runs_[MAX_RUNS - 1];
+  }
+  uint32_t total = run->seconds + seconds;
+  run->seconds = total > UINT16_MAX ? UINT16_MAX : total;
+}
+
+size_t C1001SleepSession::format_hypnogram(char *out, size_t size) const {
+  static const char LETTERS[STAGE_COUNT] = {'D', 'L', 'W', '-'};
+  static const char ELLIPSIS[] = "...";
+  if (size == 0) {
+    return 0;
+  }
+  
+  // Every run but the last leaves room for the ellipsis behind it
+  size_t len = 0;
+  out[0] = '\0';
+  for (uint8_t i = 0; i < this->summary_.runs; i++) {
+    char entry[8];
+    int n = snprintf(entry, sizeof(entry), "%s%c%u", i > 0 ? " " : "", LETTERS[this->runs_[i].stage],
+                     (this->runs_[i].seconds + 30) / 60);
+    size_t reserve = i + 1 < this->summary_.runs ? sizeof(ELLIPSIS) - 1 : 0;
+    if (len + n + reserve >= size) {
+      if (len + sizeof(ELLIPSIS) <= size) {
+        memcpy(&out[len], ELLIPSIS, sizeof(ELLIPSIS));
+        len += sizeof(ELLIPSIS) - 1;
+      }
+      break;
+    }
+    memcpy(&out[len], entry, n + 1);
+    len += n;
+  }
+  return len;
+}
+
+}  // namespace c1001
+}  // namespace esphome
@@ -0,0 +1,77 @@
+#pragma once
+
+// Incremental sleep session tracker. A session opens when the person gets into bed. It
+// closes once they have been out of bed for end_after ms, so a trip to the bathroom
+// doesn't split the night. Sessions shorter than min_duration are discarded. Sleep
+// states are kept as a run-length hypnogram and summed per stage; time out of bed
+// inside a session counts as awake. Fixed memory, no ESPHome dependencies.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace c1001 {
+
+class C1001SleepSession {
+ public:
+  // The radar's sleep states
+  static const uint8_t STAGE_DEEP = 0;
+  static const uint8_t STAGE_LIGHT = 1;
+  static const uint8_t STAGE_AWAKE = 2;
+  static const uint8_t STAGE_NONE = 3;
+  static const uint8_t STAGE_COUNT = 4;
+  static const uint8_t MAX_RUNS = 64;
+
+  struct Run {
+    uint8_t stage;
+    uint16_t seconds;                // Saturates at about 18 hours
+  };
+
+  struct Summary {
+    uint32_t start;                  // Time the person got into bed
+    uint32_t duration_s;             // Until they got out of bed for good
+    uint32_t stage_s[STAGE_COUNT];   // Time per stage
+    uint32_t sleep_onset_s;          // From getting into bed to the first deep or light sleep
+    uint16_t transitions;            // Stage changes
+    uint16_t awakenings;             // Returns to awake after having slept
+    uint8_t runs;                    // Hypnogram length
+    bool truncated;                  // More stage changes than MAX_RUNS; the last run holds the rest
+  };
+
+  void set_timing(uint32_t end_after_ms, uint32_t min_duration_ms) {
+    this->end_after_ = end_after_ms;
+    this->min_duration_ = min_duration_ms;
+  }
+  uint32_t end_after() const { return this->end_after_; }
+  uint32_t min_duration() const { return this->min_duration_; }
+
+  // Feed the current state (now in ms); call on every in-bed or sleep state sample and
+  // periodically. Returns true when a session has just ended, its summary ready.
+  bool update(uint32_t now, bool in_bed, uint8_t stage);
+  bool active() const { return this->active_; }
+
+  // The session that just ended, until the next one starts
+  const Summary &summary() const { return this->summary_; }
+  const Run &run(uint8_t index) const { return this->runs_[index]; }
+  // Write the hypnogram as "<stage letter><minutes>" runs (D deep, L light, W awake, - none),
+  // e.g. "W12 L35 D20 L40", cut short with "..." if it doesn't fit. Returns the length.
+  size_t format_hypnogram(char *out, size_t size) const;
+
+ protected:
+  void change_stage_(uint32_t now, uint8_t stage);
+  void close_run_(uint32_t now);
+
+  uint32_t end_after_{15 * 60 * 1000};
+  uint32_t min_duration_{30 * 60 * 1000};
+  bool active_{false};
+  bool slept_{false};                // Deep or light sleep seen in this session
+  uint32_t out_since_{0};            // Time the person left the bed, while out_
+  bool out_{false};
+  uint8_t stage_{STAGE_NONE};        // Stage of the open run
+  uint32_t run_start_{0};
+  Summary summary_{};                // The session in progress until it ends
+  Run runs_[MAX_RUNS]{};
+};
+
+}  // namespace c1001
+}  // namespace esphome
@@ -0,0 +1,82 @@
+#include "c1001_stats.h"
+
+#include <cmath>
+
+namespace esphome {
+namespace c1001 {
+
+void C1001RollingStats::set_window(uint32_t window_ms) {
+  this->bucket_ms_ = window_ms / BUCKETS > 0 ? window_ms / BUCKETS : 1;
+  for (auto &bucket : this->buckets_) {
+    bucket = Bucket();
+  }
+}
+
+void C1001RollingStats::add(uint32_t now, float value) {
+  uint32_t epoch = now / this->bucket_ms_;
+  Bucket &bucket = this->buckets_[epoch % BUCKETS];
+  if (bucket.count == 0 || bucket.epoch != epoch) {
+    // First sample of a new bucket, replacing whatever the slot held a window ago
+    bucket.epoch = epoch;
+    bucket.count = 1;
+    bucket.mean = value;
+    bucket.m2 = 0;
+    bucket.min = value;
+    bucket.max = value;
+    return;
+  }
+  
+  if (bucket.count < UINT16_MAX) {
+    bucket.count++;
+  } else {
+    // Full: the count stays put, so take out an average sample's share of m2 for the one
+    // coming in, or the spread would grow with every further sample
+    bucket.m2 -= bucket.m2 / (bucket.count - 1);
+  }
+  float delta = value - bucket.mean;
+  bucket.mean += delta / bucket.count;
+  bucket.m2 += delta * (value - bucket.mean);
+  if (value < bucket.min) {
+    bucket.min = value;
+  }
+  if (value > bucket.max) {
+    bucket.max = value;
+  }
+}
+
+bool C1001RollingStats::summary(uint32_t now, Summary &out) const {
+  uint32_t epoch = now / this->bucket_ms_;
+  uint32_t count = 0;
+  float mean = 0;
+  float m2 = 0;
+  for (const auto &bucket : this->buckets_) {
+    if (bucket.count == 0 || epoch - bucket.epoch >= BUCKETS) {
+      continue;
+    }
+    
+    if (count == 0) {
+      out.min = bucket.min;
+      out.max = bucket.max;
+    } else {
+      out.min = bucket.min < out.min ? bucket.min : out.min;
+      out.max = bucket.max > out.max ? bucket.max : out.max;
+    }
+    // Chan et al.'s pairwise combination of two (count, mean, m2) sets
+    uint32_t total = count + bucket.count;
+    float delta = bucket.mean - mean;
+    mean += delta * bucket.count / total;
+    m2 += bucket.m2 + delta * delta * ((float) count * bucket.count / total);
+    count = total;
+  }
+  if (count == 0) {
+    return false;
+  }
+  
+  out.count = count;
+  out.mean = mean;
+  out.stddev = count > 1 ? std::sqrt(m2 / (count - 1)) : 0.0f;
+  return true;
+}
+
+}  // namespace c1001
+}  // namespace esphome
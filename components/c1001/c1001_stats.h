@@ -0,0 +1,48 @@
+#pragma once
+
+// Sliding-window statistics (count, min, mean, max, standard deviation) over a time window,
+// kept as a ring of time buckets. Adding a sample updates one bucket in O(1) with Welford's
+// method; a summary merges the buckets, so the window slides in steps of window/BUCKETS.
+// Fixed memory, no allocation, no ESPHome dependencies.
+
+#include <cstdint>
+
+namespace esphome {
+namespace c1001 {
+
+class C1001RollingStats {
+ public:
+  static const uint8_t BUCKETS = 12;
+
+  struct Summary {
+    uint32_t count;
+    float min;
+    float max;
+    float mean;
+    float stddev;                    // Sample standard deviation, 0 below two samples
+  };
+
+  // Window length in ms; resets the statistics
+  void set_window(uint32_t window_ms);
+  uint32_t window() const { return this->bucket_ms_ * BUCKETS; }
+
+  void add(uint32_t now, float value);
+  // Merge the buckets still inside the window; false if it holds no samples
+  bool summary(uint32_t now, Summary &out) const;
+
+ protected:
+  struct Bucket {
+    uint32_t epoch{0};               // now / bucket_ms_ when the bucket was started
+    uint16_t count{0};               // Saturates; the mean and spread then keep following
+    float mean{0};
+    float m2{0};                     // Sum of squared differences from the mean
+    float min{0};
+    float max{0};
+  };
+
+  uint32_t bucket_ms_{1};
+  Bucket buckets_[BUCKETS];
+};
+
+}  // namespace c1001
+}  // namespace esphome
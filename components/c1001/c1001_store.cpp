@@ -0,0 +1,157 @@
+#include "c1001_store.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace esphome {
+namespace c1001 {
+
+// Longest record: header byte, 5 byte time gap varint, 5 byte value varint
+static const uint8_t MAX_RECORD_SIZE = 11;
+static const uint8_t TIME_ESCAPE = 0x1F;
+
+static uint8_t put_varint(uint8_t *out, uint32_t value) {
+  uint8_t len = 0;
+  while (value >= 0x80) {
+    out[len++] = (uint8_t) (value | 0x80);
+    value >>= 7;
+  }
+  out[len++] = (uint8_t) value;
+  return len;
+}
+
+// Returns the bytes consumed, 0 if the varint runs past end or is too long
+static uint8_t get_varint(const uint8_t *in, const uint8_t *end, uint32_t &value) {
+  value = 0;
+  for (uint8_t len = 0; len < 5 && in + len < end; len++) {
+    value |= (uint32_t) (in[len] & 0x7F) << (7 * len);
+    if ((in[len] & 0x80) == 0) {
+      return len + 1;
+    }
+  }
+  return 0;
+}
+
+static uint32_t zigzag(int32_t value) { return ((uint32_t) value << 1) ^ (uint32_t) (value >> 31); }
+static int32_t unzigzag(uint32_t value) { return (int32_t) (value >> 1) ^ -(int32_t) (value & 1); }
+
+void C1001NightStore::init(uint8_t *buffer, uint32_t size) {
+  this->buffer_ = buffer;
+  this->blocks_ = size / BLOCK_SIZE > UINT16_MAX ? UINT16_MAX : size / BLOCK_SIZE;
+  this->count_ = 0;
+  this->pos_ = BLOCK_SIZE;
+}
+
+void C1001NightStore::record(uint32_t now_s, uint8_t channel, float value) {
+  if (!this->enabled() || channel >= MAX_CHANNELS || std::isnan(value)) {
+    return;
+  }
+  
+  if (this->pos_ + MAX_RECORD_SIZE > BLOCK_SIZE) {
+    this->start_block_(now_s);
+  }
+  this->put_(now_s, channel, (int32_t) lroundf(value * 10.0f));
+  this->samples_++;
+}
+
+void C1001NightStore::record_change(uint32_t now_s, uint8_t channel, float value) {
+  if (channel < MAX_CHANNELS && (this->seen_ & (1 << channel)) != 0 && !std::isnan(value) &&
+      this->latest_[channel] == (int32_t) lroundf(value * 10.0f)) {
+    return;
+  }
+  this->record(now_s, channel, value);
+}
+
+// Drop the oldest block if the store is full, then open a new one with a keyframe
+void C1001NightStore::start_block_(uint32_t now_s) {
+  if (this->count_ == this->blocks_) {
+    this->count_--;
+    this->dropped_blocks_++;
+  }
+  uint8_t *block = this->block_(this->end_block());
+  this->count_++;
+  memset(block, END_OF_BLOCK, BLOCK_SIZE);
+  for (uint8_t i = 0; i < BLOCK_HEADER_SIZE; i++) {
+    block[i] = (uint8_t) (now_s >> (8 * i));
+  }
+  this->pos_ = BLOCK_HEADER_SIZE;
+  this->last_s_ = now_s;
+  
+  int32_t latest[MAX_CHANNELS];
+  memcpy(latest, this->latest_, sizeof(latest));
+  memset(this->latest_, 0, sizeof(this->latest_));
+  for (uint8_t channel = 0; channel < MAX_CHANNELS; channel++) {
+    if ((this->seen_ & (1 << channel)) != 0) {
+      this->put_(now_s, channel, latest[channel]);
+    }
+  }
+}
+
+// Encode one record into the current block, which has room for it
+void C1001NightStore::put_(uint32_t now_s, uint8_t channel, int32_t tenths) {
+  uint8_t *out = this->block_(this->end_block() - 1) + this->pos_;
+  uint8_t len = 0;
+  uint32_t gap = now_s - this->last_s_;
+  if (gap < TIME_ESCAPE) {
+    out[len++] = (uint8_t) (channel << 5 | gap);
+  } else {
+    out[len++] = (uint8_t) (channel << 5 | TIME_ESCAPE);
+    len += put_varint(&out[len], gap);
+  }
+  len += put_varint(&out[len], zigzag(tenths - this->latest_[channel]));
+  
+  this->last_s_ = now_s;
+  this->latest_[channel] = tenths;
+  this->seen_ |= 1 << channel;
+  this->pos_ += len;
+  this->encoded_bytes_ += len;
+}
+
+bool C1001NightStore::read_block(uint32_t sequence, uint8_t *out) const {
+  if (sequence < this->first_block() || sequence >= this->end_block()) {
+    return false;
+  }
+  memcpy(out, this->block_(sequence), BLOCK_SIZE);
+  return true;
+}
+
+uint16_t C1001NightStore::decode_block(const uint8_t *block, Visitor visit, void *context) {
+  const uint8_t *end = block + BLOCK_SIZE;
+  uint32_t time_s = 0;
+  for (uint8_t i = 0; i < BLOCK_HEADER_SIZE; i++) {
+    time_s |= (uint32_t) block[i] << (8 * i);
+  }
+  int32_t value[MAX_CHANNELS] = {};
+  uint16_t records = 0;
+  
+  const uint8_t *in = block + BLOCK_HEADER_SIZE;
+  while (in < end && *in != END_OF_BLOCK) {
+    uint8_t channel = *in >> 5;
+    uint32_t gap = *in & TIME_ESCAPE;
+    in++;
+    if (channel >= MAX_CHANNELS) {
+      break;
+    }
+    uint8_t len;
+    if (gap == TIME_ESCAPE) {
+      if ((len = get_varint(in, end, gap)) == 0) {
+        break;
+      }
+      in += len;
+    }
+    uint32_t delta;
+    if ((len = get_varint(in, end, delta)) == 0) {
+      break;
+    }
+    in += len;
+    
+    time_s += gap;
+    value[channel] += unzigzag(delta);
+    visit(context, time_s, channel, value[channel] / 10.0f);
+    records++;
+  }
+  return records;
+}
+
+}  // namespace c1001
+}  // namespace esphome
@@ -0,0 +1,76 @@
+#pragma once
+
+// Overnight time series of vitals and sleep state in a caller-provided byte buffer, delta
+// and varint encoded. The buffer is split into fixed-size blocks. When the store is full,
+// the oldest block is dropped whole. Every block opens with a keyframe of each channel's
+// latest value, so it decodes on its own. No ESPHome dependencies.
+//
+// Block layout: a little-endian uint32 start time in seconds, then records, then 0xFF
+// padding. A record is a header byte and a value:
+//  - header bits 5-7 hold the channel; bits 0-4 hold the seconds since the previous
+//    record, where 31 means a varint with the full gap follows.
+//  - the value is the zigzag varint difference from the channel's previous value in the
+//    block, in tenths; the first one in a block is the difference from 0.
+// Channel 7 is never used, so a 0xFF header marks the end of a block.
+
+#include <cstdint>
+
+namespace esphome {
+namespace c1001 {
+
+class C1001NightStore {
+ public:
+  static const uint16_t BLOCK_SIZE = 256;
+  static const uint8_t BLOCK_HEADER_SIZE = 4;
+  static const uint8_t MAX_CHANNELS = 7;
+  static const uint8_t END_OF_BLOCK = 0xFF;
+
+  // Use size bytes of buffer, rounded down to whole blocks; fewer than two blocks disables
+  // the store
+  void init(uint8_t *buffer, uint32_t size);
+  bool enabled() const { return this->blocks_ >= 2; }
+
+  // Append one sample; now_s is seconds on any monotonic clock (e.g. millis() / 1000)
+  void record(uint32_t now_s, uint8_t channel, float value);
+  // Same, but only if the value differs from the channel's latest, for state channels
+  void record_change(uint32_t now_s, uint8_t channel, float value);
+
+  // Blocks are numbered from 0 since boot; [first_block(), end_block()) are retained and
+  // the last of them is still being written
+  uint32_t first_block() const { return this->dropped_blocks_; }
+  uint32_t end_block() const { return this->dropped_blocks_ + this->count_; }
+  // Copy block number sequence to out (BLOCK_SIZE bytes); false if it isn't retained
+  bool read_block(uint32_t sequence, uint8_t *out) const;
+
+  uint32_t used() const { return (uint32_t) this->count_ * BLOCK_SIZE; }
+  uint32_t capacity() const { return (uint32_t) this->blocks_ * BLOCK_SIZE; }
+  uint32_t samples() const { return this->samples_; }
+  // Bytes of records written since boot, keyframes included, for the compression ratio
+  uint32_t encoded_bytes() const { return this->encoded_bytes_; }
+
+  // Decode one block, calling visit(context, time_s, channel, value) for every record.
+  // Returns the number of records, stopping early at anything malformed.
+  typedef void (*Visitor)(void *context, uint32_t time_s, uint8_t channel, float value);
+  static uint16_t decode_block(const uint8_t *block, Visitor visit, void *context);
+
+ protected:
+  uint8_t *block_(uint32_t sequence) const {
+    return this->buffer_ + (uint32_t) (sequence % this->blocks_) * BLOCK_SIZE;
+  }
+  void start_block_(uint32_t now_s);
+  void put_(uint32_t now_s, uint8_t channel, int32_t tenths);
+
+  uint8_t *buffer_{nullptr};
+  uint16_t blocks_{0};
+  uint16_t count_{0};                // Blocks in use, the last one being written
+  uint16_t pos_{BLOCK_SIZE};         // Write position in the current block
+  uint32_t last_s_{0};               // Time of the last record in the current block
+  int32_t latest_[MAX_CHANNELS]{};   // Latest value per channel, in tenths
+  uint8_t seen_{0};                  // Bit mask of the channels with a latest value
+  uint32_t samples_{0};
+  uint32_t encoded_bytes_{0};
+  uint32_t dropped_blocks_{0};
+};
+
+}  // namespace c1001
+}  // namespace esphome
@@ -2,14 +2,18 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor
 from esphome.const import (
+    ENTITY_CATEGORY_DIAGNOSTIC,
     STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
     UNIT_EMPTY,
     UNIT_BEATS_PER_MINUTE,
+    UNIT_BYTES,
+    UNIT_MILLISECOND,
     UNIT_MINUTE,
     UNIT_PERCENT,
 )
 from esphome.const import CONF_ID
-from . import CONF_RESPIRATION_RATE, CONF_HEART_RATE, CONF_PRESENCE, CONF_MOVEMENT, c1001_ns, C1001Component, CONF_C1001_ID
+from . import CONF_RESPIRATION_RATE, CONF_HEART_RATE, CONF_PRESENCE, CONF_MOVEMENT, c1001_ns, C1001Component, CONF_C1001_ID, C1001MetricId, POLL_INTERVAL_SCHEMA, register_polled_metric, PUBLISH_POLICY_SCHEMA, register_publish_policy, register_sleep_session
 
 # Additional sleep metrics
 CONF_IN_BED = "in_bed"
@@ -26,6 +30,129 @@ CONF_LARGE_BODY_MOVEMENT = "large_body_movement"
 CONF_MINOR_BODY_MOVEMENT = "minor_body_movement" 
 CONF_APNEA_EVENTS = "apnea_events"
 CONF_SLEEP_SCORE = "sleep_score"
+CONF_PRESENCE_LATENCY = "presence_latency"
+
+# Link health diagnostics. The counters map key -> unit; each key has a set_<key>_sensor setter.
+CONF_RX_BYTES = "rx_bytes"
+CONF_TX_BYTES = "tx_bytes"
+CONF_TIMEOUTS = "timeouts"
+CONF_CHECKSUM_ERRORS = "checksum_errors"
+CONF_RESYNCS = "resyncs"
+CONF_PARTIAL_FRAMES = "partial_frames"
+CONF_ROUND_TRIP_TIME = "round_trip_time"
+CONF_POLL_RATE = "poll_rate"
+CONF_VACANT_SKIPPED_POLLS = "vacant_skipped_polls"
+CONF_OCCUPANCY_WAKEUPS = "occupancy_wakeups"
+CONF_SUPPRESSED_PUBLISHES = "suppressed_publishes"
+CONF_REJECTED_OUTLIERS = "rejected_outliers"
+LINK_COUNTERS = {
+    CONF_RX_BYTES: UNIT_BYTES,
+    CONF_TX_BYTES: UNIT_BYTES,
+    CONF_TIMEOUTS: UNIT_EMPTY,
+    CONF_CHECKSUM_ERRORS: UNIT_EMPTY,
+    CONF_RESYNCS: UNIT_EMPTY,
+    CONF_PARTIAL_FRAMES: UNIT_EMPTY,
+    CONF_VACANT_SKIPPED_POLLS: UNIT_EMPTY,
+    CONF_OCCUPANCY_WAKEUPS: UNIT_EMPTY,
+    CONF_SUPPRESSED_PUBLISHES: UNIT_EMPTY,
+    CONF_REJECTED_OUTLIERS: UNIT_EMPTY,
+}
+
+# Per-night summary, published once when a sleep session ends. Maps key -> (unit, icon);
+# each key has a set_<key>_sensor setter.
+SESSION_SENSORS = {
+    "session_duration": (UNIT_MINUTE, "mdi:bed-clock"),
+    "session_asleep": (UNIT_MINUTE, "mdi:sleep"),
+    "session_deep_sleep": (UNIT_MINUTE, "mdi:power-sleep"),
+    "session_light_sleep": (UNIT_MINUTE, "mdi:weather-night"),
+    "session_awake": (UNIT_MINUTE, "mdi:eye"),
+    "session_sleep_onset": (UNIT_MINUTE, "mdi:timer-sand"),
+    "session_awakenings": (UNIT_EMPTY, "mdi:alarm"),
+    "session_efficiency": (UNIT_PERCENT, "mdi:percent"),
+}
+
+# Streaming filter for the live vitals, applied between decode and publish
+CONF_VITAL_FILTER = "vital_filter"
+CONF_MEDIAN_WINDOW = "median_window"
+CONF_OUTLIER_THRESHOLD = "outlier_threshold"
+CONF_SMOOTHING = "smoothing"
+CONF_ALPHA = "alpha"
+CONF_PROCESS_NOISE = "process_noise"
+CONF_MEASUREMENT_NOISE = "measurement_noise"
+
+VITAL_FILTER_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_VITAL_FILTER): cv.Schema(
+            {
+                cv.Optional(CONF_MEDIAN_WINDOW, default=5): cv.int_range(min=1, max=9),
+                cv.Optional(CONF_OUTLIER_THRESHOLD, default=0): cv.float_range(min=0),
+                cv.Optional(CONF_SMOOTHING, default="none"): cv.one_of("none", "ema", "kalman", lower=True),
+                cv.Optional(CONF_ALPHA, default=0.3): cv.float_range(min=0, min_included=False, max=1),
+                # Both above 0: no process noise stops the estimate following the input,
+                # and with no measurement noise either the gain is 0/0
+                cv.Optional(CONF_PROCESS_NOISE, default=0.05): cv.float_range(min=0, min_included=False),
+                cv.Optional(CONF_MEASUREMENT_NOISE, default=4.0): cv.float_range(min=0, min_included=False),
+            }
+        ),
+    }
+)
+
+
+def register_vital_filter(paren, metric, config):
+    """Set up the median/outlier stage and the smoother for a vital sign sensor."""
+    if CONF_VITAL_FILTER not in config:
+        return
+    conf = config[CONF_VITAL_FILTER]
+    cg.add(paren.set_filter(metric, conf[CONF_MEDIAN_WINDOW], conf[CONF_OUTLIER_THRESHOLD]))
+    if conf[CONF_SMOOTHING] == "ema":
+        cg.add(paren.set_filter_ema(metric, conf[CONF_ALPHA]))
+    elif conf[CONF_SMOOTHING] == "kalman":
+        cg.add(paren.set_filter_kalman(metric, conf[CONF_PROCESS_NOISE], conf[CONF_MEASUREMENT_NOISE]))
+
+# Rolling-window statistics of the live vitals, computed on the device
+CONF_HEART_RATE_STATISTICS = "heart_rate_statistics"
+CONF_RESPIRATION_STATISTICS = "respiration_statistics"
+CONF_WINDOW = "window"
+CONF_MIN = "min"
+CONF_MEAN = "mean"
+CONF_MAX = "max"
+CONF_STDDEV = "stddev"
+STATISTICS_KEYS = (CONF_MIN, CONF_MEAN, CONF_MAX, CONF_STDDEV)
+
+
+def statistics_schema(unit, icon):
+    """Up to three windows per metric, each with optional min/mean/max/stddev sensors."""
+    stat_sensor = sensor.sensor_schema(
+        unit_of_measurement=unit,
+        accuracy_decimals=1,
+        state_class=STATE_CLASS_MEASUREMENT,
+        icon=icon,
+    ).extend(PUBLISH_POLICY_SCHEMA)
+    window = cv.Schema(
+        {
+            cv.Required(CONF_WINDOW): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(min=cv.TimePeriod(minutes=1), max=cv.TimePeriod(hours=24)),
+            ),
+            **{cv.Optional(key): stat_sensor for key in STATISTICS_KEYS},
+        }
+    )
+    return cv.All(cv.ensure_list(window), cv.Length(min=1, max=3))
+
+
+async def register_statistics(paren, metric, windows):
+    # The statistics need the metric polled even without its own sensor
+    register_polled_metric(paren, metric, {})
+    for conf in windows:
+        targets = []
+        for key in STATISTICS_KEYS:
+            if key in conf:
+                sens = await sensor.new_sensor(conf[key])
+                register_publish_policy(paren, sens, conf[key])
+                targets.append(sens)
+            else:
+                targets.append(cg.nullptr)
+        cg.add(paren.add_statistics(metric, conf[CONF_WINDOW].total_milliseconds, *targets))
 
 # CONF_C1001_ID already imported from __init__.py
 
@@ -55,24 +182,31 @@ CONFIG_SCHEMA = cv.Schema(
             accuracy_decimals=1,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:lungs",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA).extend(VITAL_FILTER_SCHEMA),
         cv.Optional(CONF_HEART_RATE): sensor.sensor_schema(
             unit_of_measurement=UNIT_BEATS_PER_MINUTE,
             accuracy_decimals=1,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:heart-pulse",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA).extend(VITAL_FILTER_SCHEMA),
         cv.Optional(CONF_PRESENCE): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             accuracy_decimals=0,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:human-greeting",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
         cv.Optional(CONF_MOVEMENT): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             accuracy_decimals=0,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:motion-sensor",
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
+        cv.Optional(CONF_PRESENCE_LATENCY): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            icon="mdi:timer-outline",
         ),
         
         # Sleep metrics
@@ -81,85 +215,126 @@ CONFIG_SCHEMA = cv.Schema(
             accuracy_decimals=0,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:bed",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
         cv.Optional(CONF_SLEEP_STATE): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             accuracy_decimals=0,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:sleep",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
         cv.Optional(CONF_SLEEP_QUALITY): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             accuracy_decimals=0,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:star",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
         cv.Optional(CONF_SLEEP_QUALITY_RATING): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             accuracy_decimals=0,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:star-half-full",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
         cv.Optional(CONF_AWAKE_DURATION): sensor.sensor_schema(
             unit_of_measurement=UNIT_MINUTE,
             accuracy_decimals=0,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:sleep-off",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
         cv.Optional(CONF_LIGHT_SLEEP_DURATION): sensor.sensor_schema(
             unit_of_measurement=UNIT_MINUTE,
             accuracy_decimals=0,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:sleep",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
         cv.Optional(CONF_DEEP_SLEEP_DURATION): sensor.sensor_schema(
             unit_of_measurement=UNIT_MINUTE,
             accuracy_decimals=0,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:power-sleep",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
         cv.Optional(CONF_AVERAGE_RESPIRATION): sensor.sensor_schema(
             unit_of_measurement=UNIT_BEATS_PER_MINUTE,
             accuracy_decimals=1,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:lungs",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
         cv.Optional(CONF_AVERAGE_HEART_RATE): sensor.sensor_schema(
             unit_of_measurement=UNIT_BEATS_PER_MINUTE,
             accuracy_decimals=1,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:heart-pulse",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
         cv.Optional(CONF_TURNOVER_COUNT): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             accuracy_decimals=0,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:rotate-3d-variant",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
         cv.Optional(CONF_LARGE_BODY_MOVEMENT): sensor.sensor_schema(
             unit_of_measurement=UNIT_PERCENT,
             accuracy_decimals=0,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:human-handsup",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
         cv.Optional(CONF_MINOR_BODY_MOVEMENT): sensor.sensor_schema(
             unit_of_measurement=UNIT_PERCENT,
             accuracy_decimals=0,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:human",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
         cv.Optional(CONF_APNEA_EVENTS): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             accuracy_decimals=0,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:lungs-off",
-        ),
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
         cv.Optional(CONF_SLEEP_SCORE): sensor.sensor_schema(
             unit_of_measurement=UNIT_EMPTY,
             accuracy_decimals=0,
             state_class=STATE_CLASS_MEASUREMENT,
             icon="mdi:medal",
+        ).extend(POLL_INTERVAL_SCHEMA).extend(PUBLISH_POLICY_SCHEMA),
+        
+        # Rolling statistics, published every update_interval
+        cv.Optional(CONF_HEART_RATE_STATISTICS): statistics_schema(UNIT_BEATS_PER_MINUTE, "mdi:heart-pulse"),
+        cv.Optional(CONF_RESPIRATION_STATISTICS): statistics_schema(UNIT_BEATS_PER_MINUTE, "mdi:lungs"),
+        
+        # Link health diagnostics, published every update_interval
+        cv.Optional(CONF_ROUND_TRIP_TIME): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            accuracy_decimals=1,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            icon="mdi:timer-sync-outline",
         ),
+        cv.Optional(CONF_POLL_RATE): sensor.sensor_schema(
+            unit_of_measurement="replies/s",
+            accuracy_decimals=1,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            icon="mdi:speedometer",
+        ),
+    }
+).extend(
+    {
+        cv.Optional(key): sensor.sensor_schema(
+            unit_of_measurement=unit,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            icon="mdi:counter",
+        )
+        for key, unit in LINK_COUNTERS.items()
+    }
+).extend(
+    {
+        cv.Optional(key): sensor.sensor_schema(
+            unit_of_measurement=unit,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            icon=icon,
+        )
+        for key, (unit, icon) in SESSION_SENSORS.items()
     }
 )
 
@@ -172,89 +347,159 @@ async def to_code(config):
         conf = config[CONF_RESPIRATION_RATE]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_respiration_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_RESPIRATION, conf)
+        register_publish_policy(paren, sens, conf)
+        register_vital_filter(paren, C1001MetricId.METRIC_RESPIRATION, conf)
 
     if CONF_HEART_RATE in config:
         conf = config[CONF_HEART_RATE]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_heart_rate_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_HEART_RATE, conf)
+        register_publish_policy(paren, sens, conf)
+        register_vital_filter(paren, C1001MetricId.METRIC_HEART_RATE, conf)
 
     if CONF_PRESENCE in config:
         conf = config[CONF_PRESENCE]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_presence_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_PRESENCE, conf)
+        register_publish_policy(paren, sens, conf)
 
     if CONF_MOVEMENT in config:
         conf = config[CONF_MOVEMENT]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_movement_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_MOVEMENT, conf)
+        register_publish_policy(paren, sens, conf)
+
+    if CONF_PRESENCE_LATENCY in config:
+        conf = config[CONF_PRESENCE_LATENCY]
+        sens = await sensor.new_sensor(conf)
+        cg.add(paren.set_presence_latency_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_PRESENCE, conf)
         
     # Sleep metrics
     if CONF_IN_BED in config:
         conf = config[CONF_IN_BED]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_in_bed_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_IN_BED, conf)
+        register_publish_policy(paren, sens, conf)
         
     if CONF_SLEEP_STATE in config:
         conf = config[CONF_SLEEP_STATE]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_sleep_state_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_SLEEP_STATE, conf)
+        register_publish_policy(paren, sens, conf)
         
     if CONF_SLEEP_QUALITY in config:
         conf = config[CONF_SLEEP_QUALITY]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_sleep_quality_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_SLEEP_QUALITY, conf)
+        register_publish_policy(paren, sens, conf)
         
     if CONF_SLEEP_QUALITY_RATING in config:
         conf = config[CONF_SLEEP_QUALITY_RATING]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_sleep_quality_rating_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_SLEEP_QUALITY_RATING, conf)
+        register_publish_policy(paren, sens, conf)
         
     if CONF_AWAKE_DURATION in config:
         conf = config[CONF_AWAKE_DURATION]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_awake_duration_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_AWAKE_DURATION, conf)
+        register_publish_policy(paren, sens, conf)
         
     if CONF_LIGHT_SLEEP_DURATION in config:
         conf = config[CONF_LIGHT_SLEEP_DURATION]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_light_sleep_duration_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_LIGHT_SLEEP_DURATION, conf)
+        register_publish_policy(paren, sens, conf)
         
     if CONF_DEEP_SLEEP_DURATION in config:
         conf = config[CONF_DEEP_SLEEP_DURATION]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_deep_sleep_duration_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_DEEP_SLEEP_DURATION, conf)
+        register_publish_policy(paren, sens, conf)
         
     if CONF_AVERAGE_RESPIRATION in config:
         conf = config[CONF_AVERAGE_RESPIRATION]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_average_respiration_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_SLEEP_COMPOSITE, conf)
+        register_publish_policy(paren, sens, conf)
         
     if CONF_AVERAGE_HEART_RATE in config:
         conf = config[CONF_AVERAGE_HEART_RATE]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_average_heart_rate_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_SLEEP_COMPOSITE, conf)
+        register_publish_policy(paren, sens, conf)
         
     if CONF_TURNOVER_COUNT in config:
         conf = config[CONF_TURNOVER_COUNT]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_turnover_count_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_SLEEP_COMPOSITE, conf)
+        register_publish_policy(paren, sens, conf)
         
     if CONF_LARGE_BODY_MOVEMENT in config:
         conf = config[CONF_LARGE_BODY_MOVEMENT]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_large_body_movement_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_SLEEP_COMPOSITE, conf)
+        register_publish_policy(paren, sens, conf)
         
     if CONF_MINOR_BODY_MOVEMENT in config:
         conf = config[CONF_MINOR_BODY_MOVEMENT]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_minor_body_movement_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_SLEEP_COMPOSITE, conf)
+        register_publish_policy(paren, sens, conf)
         
     if CONF_APNEA_EVENTS in config:
         conf = config[CONF_APNEA_EVENTS]
         sens = await sensor.new_sensor(conf)
         cg.add(paren.set_apnea_events_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_SLEEP_COMPOSITE, conf)
+        register_publish_policy(paren, sens, conf)
         
     if CONF_SLEEP_SCORE in config:
         conf = config[CONF_SLEEP_SCORE]
         sens = await sensor.new_sensor(conf)
-        cg.add(paren.set_sleep_score_sensor(sens))
\ No newline at end of file
+        cg.add(paren.set_sleep_score_sensor(sens))
+        register_polled_metric(paren, C1001MetricId.METRIC_SLEEP_STATISTICS, conf)
+        register_publish_policy(paren, sens, conf)
+
+    if CONF_HEART_RATE_STATISTICS in config:
+        await register_statistics(paren, C1001MetricId.METRIC_HEART_RATE, config[CONF_HEART_RATE_STATISTICS])
+    if CONF_RESPIRATION_STATISTICS in config:
+        await register_statistics(paren, C1001MetricId.METRIC_RESPIRATION, config[CONF_RESPIRATION_STATISTICS])
+
+    # Sleep session summary
+    for key in SESSION_SENSORS:
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(paren, f"set_{key}_sensor")(sens))
+            register_sleep_session(paren)
+
+    # Link health diagnostics
+    for key in LINK_COUNTERS:
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(paren, f"set_{key}_sensor")(sens))
+    
+    if CONF_ROUND_TRIP_TIME in config:
+        sens = await sensor.new_sensor(config[CONF_ROUND_TRIP_TIME])
+        cg.add(paren.set_round_trip_time_sensor(sens))
+    
+    if CONF_POLL_RATE in config:
+        sens = await sensor.new_sensor(config[CONF_POLL_RATE])
+        cg.add(paren.set_poll_rate_sensor(sens))
@@ -0,0 +1,25 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import text_sensor
+from . import C1001Component, CONF_C1001_ID, register_sleep_session
+
+# Run-length hypnogram of the last sleep session, e.g. "W12 L35 D20 L40"
+CONF_SESSION_HYPNOGRAM = "session_hypnogram"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.Required(CONF_C1001_ID): cv.use_id(C1001Component),
+        cv.Optional(CONF_SESSION_HYPNOGRAM): text_sensor.text_sensor_schema(
+            icon="mdi:chart-timeline-variant",
+        ),
+    }
+)
+
+
+async def to_code(config):
+    paren = await cg.get_variable(config[CONF_C1001_ID])
+
+    if CONF_SESSION_HYPNOGRAM in config:
+        sens = await text_sensor.new_text_sensor(config[CONF_SESSION_HYPNOGRAM])
+        cg.add(paren.set_session_hypnogram_text_sensor(sens))
+        register_sleep_session(paren)
@@ -0,0 +1,90 @@
+#include "host_test.h"
+
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+namespace esphome {
+
+namespace setup_priority {
+const float DATA = 600.0f;
+}  // namespace setup_priority
+
+static uint64_t clock_us = 0;
+static uint32_t log_counts[HOST_LOG_LEVELS]{0};
+static uint32_t check_failures = 0;
+static uint32_t checks = 0;
+
+uint32_t millis() { return (uint32_t) (clock_us / 1000); }
+uint32_t micros() { return (uint32_t) clock_us; }
+void delay(uint32_t ms) { clock_us += (uint64_t) ms * 1000; }
+void yield() {}
+
+void host_log(HostLogLevel level, const char *tag, const char *format, ...) {
+  static const char LETTERS[HOST_LOG_LEVELS] = {'E', 'W', 'I', 'C', 'D', 'V'};
+  static const bool verbose = getenv("C1001_TEST_VERBOSE") != nullptr;
+  log_counts[level]++;
+  if (!verbose) {
+    return;
+  }
+  
+  va_list args;
+  va_start(args, format);
+  printf("[%010u][%c][%s] ", millis(), LETTERS[level], tag);
+  vprintf(format, args);
+  printf("\n");
+  va_end(args);
+}
+
+std::string format_hex_pretty(const uint8_t *data, size_t length) {
+  std::string out;
+  char hex[4];
+  for (size_t i = 0; i < length; i++) {
+    snprintf(hex, sizeof(hex), i + 1 < length ? "%02X." : "%02X", data[i]);
+    out += hex;
+  }
+  return out;
+}
+
+namespace testing {
+
+void advance_us(uint32_t us) { clock_us += us; }
+void advance_ms(uint32_t ms) { clock_us += (uint64_t) ms * 1000; }
+uint64_t now_us() { return clock_us; }
+
+uint32_t log_count(HostLogLevel level) { return log_counts[level]; }
+void reset_log_counts() {
+  for (auto &count : log_counts) {
+    count = 0;
+  }
+}
+
+void check(bool ok, const char *expression, const char *file, int line) {
+  checks++;
+  if (!ok) {
+    check_failures++;
+    printf("%s:%d: CHECK failed: %s\n", file, line, expression);
+  }
+}
+
+void check_near(double actual, double expected, double tolerance, const char *expression, const char *file,
+                int line) {
+  checks++;
+  if (!(std::fabs(actual - expected) <= tolerance)) {
+    check_failures++;
+    printf("%s:%d: CHECK failed: %s is %g, expected %g +- %g\n", file, line, expression, actual, expected, tolerance);
+  }
+}
+
+int finish() {
+  printf("%u checks, %u failed\n", checks, check_failures);
+  return check_failures == 0 ? 0 : 1;
+}
+
+}  // namespace testing
+}  // namespace esphome
@@ -0,0 +1,53 @@
+#pragma once
+
+// An in-memory UART. The component writes requests into it and reads back whatever the
+// radar side (usually a RadarEmulator) has put on the line.
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "esphome/components/uart/uart.h"
+
+namespace esphome {
+namespace testing {
+
+class FakeUart : public uart::UARTComponent {
+ public:
+  // Component side
+  void write_array(const uint8_t *data, size_t len) override {
+    this->written_.insert(this->written_.end(), data, data + len);
+  }
+  bool peek_byte(uint8_t *data) override {
+    if (this->line_.empty()) {
+      return false;
+    }
+    *data = this->line_.front();
+    return true;
+  }
+  bool read_array(uint8_t *data, size_t len) override {
+    if (this->line_.size() < len) {
+      return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+      data[i] = this->line_.front();
+      this->line_.pop_front();
+    }
+    return true;
+  }
+  int available() override { return (int) this->line_.size(); }
+  void flush() override {}
+  
+  // Radar side: bytes to be received by the component, and the bytes it has sent so far
+  void send(const std::vector<uint8_t> &bytes) { this->line_.insert(this->line_.end(), bytes.begin(), bytes.end()); }
+  std::vector<uint8_t> &written() { return this->written_; }
+  size_t unread() const { return this->line_.size(); }
+
+ protected:
+  std::deque<uint8_t> line_;
+  std::vector<uint8_t> written_;
+};
+
+}  // namespace testing
+}  // namespace esphome
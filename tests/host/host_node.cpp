@@ -0,0 +1,64 @@
+#include "host_node.h"
+
+#include "host_test.h"
+
+namespace esphome {
+namespace testing {
+
+// Polls go out this long after the radar acknowledges the reset (RESET_SETTLE_MS)
+static const uint32_t RESET_SETTLE_MS = 1000;
+
+void HostNode::add(c1001::C1001Component *component, RadarEmulator *radar) {
+  this->entries_.push_back(Entry{component, radar, 0});
+}
+
+bool HostNode::start(uint32_t max_ms) {
+  for (auto &entry : this->entries_) {
+    entry.component->setup();
+    entry.next_update = millis();
+  }
+  bool ready = this->run_until(
+      [this]() {
+        for (auto &entry : this->entries_) {
+          if (!entry.radar->reset_answered()) {
+            return false;
+          }
+        }
+        return true;
+      },
+      max_ms);
+  this->run(RESET_SETTLE_MS);
+  return ready;
+}
+
+void HostNode::run(uint32_t ms) {
+  for (uint32_t i = 0; i < ms; i++) {
+    this->tick_();
+  }
+}
+
+bool HostNode::run_until(const std::function<bool()> &done, uint32_t max_ms) {
+  for (uint32_t i = 0; i < max_ms; i++) {
+    if (done()) {
+      return true;
+    }
+    this->tick_();
+  }
+  return done();
+}
+
+void HostNode::tick_() {
+  advance_ms(1);
+  uint32_t now = millis();
+  for (auto &entry : this->entries_) {
+    if ((int32_t) (now - entry.next_update) >= 0) {
+      entry.component->update();
+      entry.next_update = now + entry.component->get_update_interval();
+    }
+    entry.component->loop();
+    entry.radar->step();
+  }
+}
+
+}  // namespace testing
+}  // namespace esphome
@@ -0,0 +1,42 @@
+#pragma once
+
+// Drives C1001 components the way the ESPHome main loop does, against simulated time:
+// one loop() per component every millisecond, update() at each update interval, and the
+// radar emulators stepped after every pass.
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "c1001.h"
+#include "radar_emulator.h"
+
+namespace esphome {
+namespace testing {
+
+class HostNode {
+ public:
+  void add(c1001::C1001Component *component, RadarEmulator *radar);
+  
+  // setup() every component, then run until every radar has finished the handshake and
+  // the post-reset settle time is over. Returns false if that takes longer than max_ms.
+  bool start(uint32_t max_ms = 60000);
+  // Run for ms of simulated time
+  void run(uint32_t ms);
+  // Run until done() returns true; false if max_ms went by first
+  bool run_until(const std::function<bool()> &done, uint32_t max_ms);
+
+ protected:
+  struct Entry {
+    c1001::C1001Component *component;
+    RadarEmulator *radar;
+    uint32_t next_update;
+  };
+  
+  void tick_();
+  
+  std::vector<Entry> entries_;
+};
+
+}  // namespace testing
+}  // namespace esphome
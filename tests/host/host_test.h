@@ -0,0 +1,32 @@
+#pragma once
+
+// Shared pieces of the host tests: the simulated clock, log counters and CHECK macros.
+// Tests return esphome::testing::finish() from main(); ctest treats non-zero as failed.
+
+#include <cstdint>
+
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace testing {
+
+// The simulated clock behind millis() and micros(); delay() advances it as well
+void advance_us(uint32_t us);
+void advance_ms(uint32_t ms);
+uint64_t now_us();
+
+// Messages logged at a level since the last reset
+uint32_t log_count(HostLogLevel level);
+void reset_log_counts();
+
+void check(bool ok, const char *expression, const char *file, int line);
+void check_near(double actual, double expected, double tolerance, const char *expression, const char *file, int line);
+// Print the verdict and return the exit code
+int finish();
+
+}  // namespace testing
+}  // namespace esphome
+
+#define CHECK(expression) ::esphome::testing::check((expression), #expression, __FILE__, __LINE__)
+#define CHECK_NEAR(actual, expected, tolerance) \
+  ::esphome::testing::check_near((actual), (expected), (tolerance), #actual, __FILE__, __LINE__)
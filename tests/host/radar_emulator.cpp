@@ -0,0 +1,104 @@
+#include "radar_emulator.h"
+
+#include "esphome/core/hal.h"
+
+namespace esphome {
+namespace testing {
+
+// Every request the component sends is exactly this long (C1001_FRAME_SIZE)
+static const size_t REQUEST_SIZE = 10;
+
+RadarEmulator::RadarEmulator(FakeUart *uart) : uart_(uart) {
+  // Initialization handshake: LED query, work mode query (already in sleep mode), LED on, reset
+  this->set_register(0x01, 0x83, {0x01});
+  this->set_register(0x02, 0xA8, {0x02});
+  this->set_register(0x01, 0x03, {0x01});
+  this->set_register(0x01, 0x02, {0x0F});
+}
+
+std::vector<uint8_t> RadarEmulator::frame(uint8_t con, uint8_t cmd, const std::vector<uint8_t> &data) {
+  std::vector<uint8_t> bytes{0x53, 0x59, con, cmd, (uint8_t) (data.size() >> 8), (uint8_t) data.size()};
+  bytes.reserve(bytes.size() + data.size() + 3);
+  for (uint8_t byte : data) {
+    bytes.push_back(byte);
+  }
+  uint8_t checksum = 0;
+  for (uint8_t byte : bytes) {
+    checksum += byte;
+  }
+  bytes.push_back(checksum);
+  bytes.push_back(0x54);
+  bytes.push_back(0x43);
+  return bytes;
+}
+
+void RadarEmulator::set_register(uint8_t con, uint8_t cmd, const std::vector<uint8_t> &data) {
+  this->registers_[key_(con, cmd)] = data;
+}
+
+void RadarEmulator::clear_register(uint8_t con, uint8_t cmd) { this->registers_.erase(key_(con, cmd)); }
+
+void RadarEmulator::push(uint8_t con, uint8_t cmd, const std::vector<uint8_t> &data) {
+  this->schedule_(millis(), frame(con, cmd, data));
+}
+
+void RadarEmulator::replay(uint32_t at_ms, const std::vector<uint8_t> &bytes) {
+  this->schedule_(at_ms, std::vector<uint8_t>(bytes));
+}
+
+uint32_t RadarEmulator::requests(uint8_t con, uint8_t cmd) const {
+  auto it = this->requests_.find(key_(con, cmd));
+  return it == this->requests_.end() ? 0 : it->second;
+}
+
+void RadarEmulator::step() {
+  this->take_requests_();
+  
+  uint32_t now = millis();
+  size_t sent = 0;
+  while (sent < this->scheduled_.size() && (int32_t) (now - this->scheduled_[sent].due) >= 0) {
+    if (!this->silent_) {
+      this->uart_->send(this->scheduled_[sent].bytes);
+    }
+    sent++;
+  }
+  this->scheduled_.erase(this->scheduled_.begin(), this->scheduled_.begin() + sent);
+}
+
+// Requests are fixed-size frames; anything that doesn't start with the header is skipped
+void RadarEmulator::take_requests_() {
+  std::vector<uint8_t> &written = this->uart_->written();
+  size_t pos = 0;
+  while (written.size() - pos >= REQUEST_SIZE) {
+    if (written[pos] != 0x53 || written[pos + 1] != 0x59) {
+      pos++;
+      continue;
+    }
+    uint8_t con = written[pos + 2];
+    uint8_t cmd = written[pos + 3];
+    pos += REQUEST_SIZE;
+    this->requests_[key_(con, cmd)]++;
+    this->total_requests_++;
+    
+    auto reg = this->registers_.find(key_(con, cmd));
+    if (this->silent_ || reg == this->registers_.end()) {
+      continue;
+    }
+    if (con == 0x01 && cmd == 0x02) {
+      this->reset_answered_ = true;
+    }
+    this->schedule_(millis() + this->reply_delay_ms_, frame(con, cmd, reg->second));
+  }
+  written.erase(written.begin(), written.begin() + pos);
+}
+
+void RadarEmulator::schedule_(uint32_t due, std::vector<uint8_t> &&bytes) {
+  auto it = this->scheduled_.end();
+  while (it != this->scheduled_.begin() && (int32_t) ((it - 1)->due - due) > 0) {
+    --it;
+  }
+  this->scheduled_.insert(it, Scheduled{due, std::move(bytes)});
+}
+
+}  // namespace testing
+}  // namespace esphome
@@ -0,0 +1,67 @@
+#pragma once
+
+// Plays the radar on the far end of a FakeUart. Requests written by the component are
+// answered from a register table, after an optional reply delay; unsolicited reports and
+// arbitrary byte sequences (corrupt or cut-off frames) can be scripted at given times.
+// Everything happens in step(), which the test calls after every loop() pass.
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "fake_uart.h"
+
+namespace esphome {
+namespace testing {
+
+class RadarEmulator {
+ public:
+  explicit RadarEmulator(FakeUart *uart);
+  
+  // A complete frame as the radar sends it: header, big-endian length, data, checksum, end bytes
+  static std::vector<uint8_t> frame(uint8_t con, uint8_t cmd, const std::vector<uint8_t> &data);
+  
+  // Answer requests for con:cmd with data; registers without an entry are never answered.
+  // The initialization handshake (LED, work mode, reset) is answered out of the box.
+  void set_register(uint8_t con, uint8_t cmd, const std::vector<uint8_t> &data);
+  void clear_register(uint8_t con, uint8_t cmd);
+  // Time between a request arriving and its reply being put on the line
+  void set_reply_delay(uint32_t reply_delay_ms) { this->reply_delay_ms_ = reply_delay_ms; }
+  // A silent radar swallows requests and sends nothing, scripted bytes included
+  void set_silent(bool silent) { this->silent_ = silent; }
+  
+  // Send an unsolicited report on the next step
+  void push(uint8_t con, uint8_t cmd, const std::vector<uint8_t> &data);
+  // Send these bytes once millis() reaches at_ms
+  void replay(uint32_t at_ms, const std::vector<uint8_t> &bytes);
+  
+  // Take in the requests written since the last step and send whatever is due
+  void step();
+  
+  uint32_t requests() const { return this->total_requests_; }
+  uint32_t requests(uint8_t con, uint8_t cmd) const;
+  // The reset request that ends the initialization handshake has been answered
+  bool reset_answered() const { return this->reset_answered_; }
+
+ protected:
+  struct Scheduled {
+    uint32_t due;
+    std::vector<uint8_t> bytes;
+  };
+  
+  static uint16_t key_(uint8_t con, uint8_t cmd) { return (uint16_t) (con << 8 | cmd); }
+  void take_requests_();
+  void schedule_(uint32_t due, std::vector<uint8_t> &&bytes);
+  
+  FakeUart *uart_;
+  std::map<uint16_t, std::vector<uint8_t>> registers_;
+  std::map<uint16_t, uint32_t> requests_;
+  uint32_t total_requests_{0};
+  std::vector<Scheduled> scheduled_;  // In due order
+  uint32_t reply_delay_ms_{0};
+  bool silent_{false};
+  bool reset_answered_{false};
+};
+
+}  // namespace testing
+}  // namespace esphome
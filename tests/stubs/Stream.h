@@ -0,0 +1,16 @@
+#pragma once
+
+// Host stand-in for the Arduino Stream interface, as much of it as UARTToStream overrides
+
+#include <cstddef>
+#include <cstdint>
+
+class Stream {
+ public:
+  virtual ~Stream() = default;
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  virtual size_t write(uint8_t data) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size) = 0;
+};
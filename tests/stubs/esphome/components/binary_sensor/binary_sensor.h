@@ -0,0 +1,34 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace binary_sensor {
+
+class BinarySensor {
+ public:
+  explicit BinarySensor(const std::string &name = "binary_sensor") : name_(name) {}
+  
+  void publish_state(bool state) {
+    this->state = state;
+    this->has_state_ = true;
+    for (auto &callback : this->callbacks_) {
+      callback(state);
+    }
+  }
+  void add_on_state_callback(std::function<void(bool)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+  bool has_state() const { return this->has_state_; }
+  const std::string &get_name() const { return this->name_; }
+  
+  bool state{false};
+
+ protected:
+  std::string name_;
+  bool has_state_{false};
+  std::vector<std::function<void(bool)>> callbacks_;
+};
+
+}  // namespace binary_sensor
+}  // namespace esphome
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+
+namespace esphome {
+namespace text_sensor {
+
+class TextSensor {
+ public:
+  explicit TextSensor(const std::string &name = "text_sensor") : name_(name) {}
+  
+  void publish_state(const std::string &state) {
+    this->state = state;
+    this->has_state_ = true;
+  }
+  bool has_state() const { return this->has_state_; }
+  const std::string &get_name() const { return this->name_; }
+  
+  std::string state;
+
+ protected:
+  std::string name_;
+  bool has_state_{false};
+};
+
+}  // namespace text_sensor
+}  // namespace esphome
@@ -0,0 +1,62 @@
+#pragma once
+
+// Host stand-in for the ESPHome UART API. UARTComponent is the bus, UARTDevice the
+// component's handle on it; tests plug in a FakeUart (tests/host/fake_uart.h) per radar.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace uart {
+
+class UARTComponent {
+ public:
+  virtual ~UARTComponent() = default;
+  virtual void write_array(const uint8_t *data, size_t len) = 0;
+  virtual bool peek_byte(uint8_t *data) = 0;
+  virtual bool read_array(uint8_t *data, size_t len) = 0;
+  virtual int available() = 0;
+  virtual void flush() = 0;
+  
+  void set_baud_rate(uint32_t baud_rate) { this->baud_rate_ = baud_rate; }
+  uint32_t get_baud_rate() const { return this->baud_rate_; }
+
+ protected:
+  uint32_t baud_rate_{115200};
+};
+
+class UARTDevice {
+ public:
+  UARTDevice() = default;
+  explicit UARTDevice(UARTComponent *parent) : parent_(parent) {}
+  
+  void set_uart_parent(UARTComponent *parent) { this->parent_ = parent; }
+  
+  void write_byte(uint8_t data) { this->parent_->write_array(&data, 1); }
+  void write_array(const uint8_t *data, size_t len) { this->parent_->write_array(data, len); }
+  bool read_byte(uint8_t *data) { return this->parent_->read_array(data, 1); }
+  bool read_array(uint8_t *data, size_t len) { return this->parent_->read_array(data, len); }
+  bool peek_byte(uint8_t *data) { return this->parent_->peek_byte(data); }
+  int available() { return this->parent_->available(); }
+  void flush() { this->parent_->flush(); }
+  
+  // Arduino Stream style
+  int read() {
+    uint8_t data;
+    return this->read_byte(&data) ? data : -1;
+  }
+  size_t write(uint8_t data) {
+    this->write_byte(data);
+    return 1;
+  }
+  int peek() {
+    uint8_t data;
+    return this->peek_byte(&data) ? data : -1;
+  }
+
+ protected:
+  UARTComponent *parent_{nullptr};
+};
+
+}  // namespace uart
+}  // namespace esphome
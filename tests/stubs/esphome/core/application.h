@@ -0,0 +1,4 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
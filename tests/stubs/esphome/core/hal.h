@@ -0,0 +1,14 @@
+#pragma once
+
+// Host stand-in for esphome/core/hal.h. The clock is simulated, see tests/host/host_test.h.
+
+#include <cstdint>
+
+namespace esphome {
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void yield();
+
+}  // namespace esphome
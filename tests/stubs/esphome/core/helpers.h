@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace esphome {
+
+std::string format_hex_pretty(const uint8_t *data, size_t length);
+
+}  // namespace esphome
@@ -0,0 +1,124 @@
+// Vital sign filter: the running median against a brute-force one, outlier rejection and
+// recovery after a lasting step, the EMA, and the Kalman smoother converging on a noisy
+// input without ever going NaN.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "c1001_filter.h"
+#include "host_test.h"
+
+using namespace esphome;
+using namespace esphome::testing;
+using c1001::C1001VitalFilter;
+
+// Small deterministic generator, so a failure reproduces
+static uint32_t random_state = 99;
+static uint32_t random_next() {
+  random_state = random_state * 1103515245 + 12345;
+  return random_state >> 8;
+}
+
+static void median() {
+  // Every window size, on input with plenty of repeats so evicting by value is exercised
+  for (uint8_t window = 1; window <= C1001VitalFilter::MAX_MEDIAN_WINDOW; window++) {
+    C1001VitalFilter filter;
+    filter.set_median_window(window);
+    std::vector<float> history;
+    for (int i = 0; i < 1000; i++) {
+      float value = 50 + random_next() % 20;
+      history.push_back(value);
+      float out;
+      CHECK(filter.apply(value, out));
+      
+      std::vector<float> last(history.end() - std::min<size_t>(history.size(), window), history.end());
+      std::sort(last.begin(), last.end());
+      CHECK(out == last[last.size() / 2]);
+    }
+  }
+  
+  // Asking for more than the maximum clamps it
+  C1001VitalFilter filter;
+  filter.set_median_window(20);
+  float out = 0;
+  for (int i = 0; i < 20; i++) {
+    filter.apply(i, out);
+  }
+  CHECK(out == 15);
+}
+
+static void outliers() {
+  C1001VitalFilter filter;
+  filter.set_median_window(5);
+  filter.set_outlier_threshold(10);
+  float out = 0;
+  for (int i = 0; i < 5; i++) {
+    CHECK(filter.apply(60, out));
+  }
+  
+  // A lone spike is dropped and the output holds
+  CHECK(!filter.apply(120, out));
+  CHECK(filter.apply(61, out) && out == 60);
+  CHECK(filter.outliers() == 1);
+  
+  // A lasting step is rejected until it holds the window's median, then gets through
+  int rejected = 0;
+  while (!filter.apply(100, out)) {
+    rejected++;
+    CHECK(rejected < 5);
+  }
+  CHECK(rejected == 2);
+  CHECK(out == 100);
+  CHECK(filter.outliers() == 3);
+  
+  // NaN never reaches the window
+  CHECK(!filter.apply(NAN, out));
+  CHECK(filter.apply(100, out) && out == 100);
+}
+
+static void ema() {
+  C1001VitalFilter filter;
+  filter.set_ema(0.5f);
+  float out;
+  CHECK(filter.apply(0, out) && out == 0);
+  CHECK(filter.apply(10, out) && out == 5);
+  CHECK(filter.apply(10, out) && out == 7.5f);
+  for (int i = 0; i < 30; i++) {
+    filter.apply(10, out);
+  }
+  CHECK_NEAR(out, 10, 0.001);
+}
+
+static void kalman() {
+  // Noisy samples around 70 settle close to it, and a step to 80 is followed
+  C1001VitalFilter filter;
+  filter.set_kalman(0.05f, 4.0f);
+  float out = 0;
+  for (int i = 0; i < 300; i++) {
+    filter.apply(70 + (float) (random_next() % 9) - 4, out);
+  }
+  CHECK_NEAR(out, 70, 1.0);
+  for (int i = 0; i < 100; i++) {
+    filter.apply(80, out);
+  }
+  CHECK_NEAR(out, 80, 0.5);
+  
+  // No noise at all: the gain would be 0/0, so the estimate follows the input instead
+  C1001VitalFilter noiseless;
+  noiseless.set_kalman(0, 0);
+  const float samples[] = {60, 61, 62};
+  for (float sample : samples) {
+    CHECK(noiseless.apply(sample, out));
+    CHECK(out == sample);
+  }
+}
+
+int main() {
+  median();
+  outliers();
+  ema();
+  kalman();
+  return finish();
+}
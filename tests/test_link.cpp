@@ -0,0 +1,66 @@
+// End to end over the emulated link: initialization handshake, polled replies published,
+// and a radar that stops answering counted as timeouts.
+
+#include "host_node.h"
+#include "host_test.h"
+
+using namespace esphome;
+using namespace esphome::testing;
+
+int main() {
+  FakeUart uart;
+  RadarEmulator radar(&uart);
+  radar.set_register(0x85, 0x82, {72});  // Heart rate
+  radar.set_register(0x81, 0x82, {18});  // Respiration
+  
+  c1001::C1001Component radar_component;
+  sensor::Sensor heart_rate("heart_rate");
+  sensor::Sensor respiration("respiration");
+  sensor::Sensor timeouts("timeouts");
+  radar_component.set_uart_parent(&uart);
+  radar_component.set_update_interval(1000);
+  radar_component.set_heart_rate_sensor(&heart_rate);
+  radar_component.set_respiration_sensor(&respiration);
+  radar_component.set_timeouts_sensor(&timeouts);
+  radar_component.add_polled_metric(c1001::METRIC_HEART_RATE, 0);
+  radar_component.add_polled_metric(c1001::METRIC_RESPIRATION, 0);
+  
+  HostNode node;
+  node.add(&radar_component, &radar);
+  CHECK(node.start());
+  CHECK(radar.requests(0x01, 0x83) == 1);
+  CHECK(radar.requests(0x02, 0xA8) == 1);
+  CHECK(radar.requests(0x01, 0x02) == 1);
+  
+  // One poll per update interval for each vital
+  uint32_t polls = radar.requests(0x85, 0x82);
+  node.run(10000);
+  CHECK(radar.requests(0x85, 0x82) - polls == 10);
+  CHECK_NEAR(heart_rate.state, 72.0, 0.01);
+  CHECK_NEAR(respiration.state, 18.0, 0.01);
+  CHECK(timeouts.state == 0);
+  
+  // Unanswered polls are retried once, then counted as failed reads
+  radar.set_silent(true);
+  node.run(10000);
+  CHECK(timeouts.state >= 4);
+  CHECK(log_count(HOST_LOG_WARN) > 0);
+  
+  // ...and the link picks up again as soon as the radar does
+  radar.set_silent(false);
+  radar.set_register(0x85, 0x82, {80});
+  node.run(3000);
+  CHECK_NEAR(heart_rate.state, 80.0, 0.01);
+  
+  // A reset asked for from outside the link only raises a flag; the link side then clears
+  // its queue and runs the handshake again
+  radar_component.reset_initialization();
+  CHECK(radar.requests(0x01, 0x83) == 1);
+  node.run(10000);
+  CHECK(radar.requests(0x01, 0x83) == 2);
+  CHECK(radar.requests(0x01, 0x02) == 2);
+  polls = radar.requests(0x85, 0x82);
+  node.run(5000);
+  CHECK(radar.requests(0x85, 0x82) > polls);
+  return finish();
+}
@@ -0,0 +1,71 @@
+// Link health counters: a frame cut short by the next header counts as partial rather than
+// as a checksum failure, a retried request's round trip is timed from its first send, and
+// checksum warnings are rate limited per error rather than per loop pass.
+
+#include "host_node.h"
+#include "host_test.h"
+
+using namespace esphome;
+using namespace esphome::testing;
+
+int main() {
+  FakeUart uart;
+  RadarEmulator radar(&uart);
+  radar.set_register(0x85, 0x82, {72});  // Heart rate
+  
+  c1001::C1001Component radar_component;
+  sensor::Sensor heart_rate("heart_rate");
+  sensor::Sensor round_trip_time("round_trip_time");
+  sensor::Sensor checksum_errors("checksum_errors");
+  sensor::Sensor partial_frames("partial_frames");
+  radar_component.set_uart_parent(&uart);
+  radar_component.set_update_interval(10000);
+  radar_component.set_push_reports(false);
+  radar_component.set_heart_rate_sensor(&heart_rate);
+  radar_component.set_round_trip_time_sensor(&round_trip_time);
+  radar_component.set_checksum_errors_sensor(&checksum_errors);
+  radar_component.set_partial_frames_sensor(&partial_frames);
+  radar_component.add_polled_metric(c1001::METRIC_HEART_RATE, 0);
+  
+  HostNode node;
+  node.add(&radar_component, &radar);
+  CHECK(node.start());
+  
+  // A heart rate report cut off after its length, then a complete one. The checksum check
+  // lands on the second frame's header, but the first frame is partial, not corrupt.
+  std::vector<uint8_t> bytes = RadarEmulator::frame(0x85, 0x02, {70});
+  bytes.resize(6);
+  std::vector<uint8_t> whole = RadarEmulator::frame(0x85, 0x02, {71});
+  bytes.insert(bytes.end(), whole.begin(), whole.end());
+  radar.replay(millis() + 10, bytes);
+  node.run(10000);
+  CHECK(partial_frames.state == 1);
+  CHECK(checksum_errors.state == 0);
+  
+  // Replies slower than the response timeout: every poll is retried, and the late reply to
+  // the first send answers it. The round trip spans both attempts.
+  radar.set_reply_delay(2500);
+  node.run(30000);
+  CHECK(round_trip_time.has_state());
+  CHECK_NEAR(round_trip_time.state, 2500.0, 20.0);
+  CHECK(heart_rate.state == 72);
+  
+  // Checksum warnings: the first error is logged, the next one within the minute held back.
+  // Nothing is logged once the minute is up unless another error arrives, and that warning
+  // then reports both.
+  radar.set_reply_delay(0);
+  node.run(5000);
+  std::vector<uint8_t> corrupt = RadarEmulator::frame(0x85, 0x02, {70});
+  corrupt[7]++;
+  reset_log_counts();
+  radar.replay(millis() + 10, corrupt);
+  radar.replay(millis() + 10000, corrupt);
+  node.run(70000);
+  CHECK(log_count(HOST_LOG_WARN) == 1);
+  radar.replay(millis() + 10, corrupt);
+  node.run(1000);
+  CHECK(log_count(HOST_LOG_WARN) == 2);
+  node.run(10000);
+  CHECK(checksum_errors.state == 3);
+  return finish();
+}
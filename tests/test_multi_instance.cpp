@@ -0,0 +1,64 @@
+// Two radars on one node, each on its own UART. Silencing one must not hold up the other:
+// its queue keeps draining and its sensors keep publishing at the same rate.
+
+#include "host_node.h"
+#include "host_test.h"
+
+using namespace esphome;
+using namespace esphome::testing;
+
+struct Radar {
+  explicit Radar(const char *name) : radar(&uart), heart_rate(name), timeouts(name) {
+    this->radar.set_register(0x85, 0x82, {72});
+    this->radar.set_register(0x81, 0x82, {18});
+    this->component.set_uart_parent(&this->uart);
+    this->component.set_update_interval(1000);
+    this->component.set_heart_rate_sensor(&this->heart_rate);
+    this->component.set_timeouts_sensor(&this->timeouts);
+    this->component.add_polled_metric(c1001::METRIC_HEART_RATE, 0);
+    this->component.add_polled_metric(c1001::METRIC_RESPIRATION, 0);
+    this->heart_rate.add_on_state_callback([this](float state) { this->publishes++; });
+  }
+  
+  FakeUart uart;
+  RadarEmulator radar;
+  c1001::C1001Component component;
+  sensor::Sensor heart_rate;
+  sensor::Sensor timeouts;
+  uint32_t publishes{0};
+};
+
+int main() {
+  Radar bedroom("bedroom");
+  Radar nursery("nursery");
+  HostNode node;
+  node.add(&bedroom.component, &bedroom.radar);
+  node.add(&nursery.component, &nursery.radar);
+  CHECK(node.start());
+  
+  node.run(1000);
+  uint32_t healthy_publishes = bedroom.publishes;
+  uint32_t healthy_requests = bedroom.radar.requests();
+  node.run(20000);
+  healthy_publishes = bedroom.publishes - healthy_publishes;
+  healthy_requests = bedroom.radar.requests() - healthy_requests;
+  CHECK(healthy_publishes >= 19);
+  
+  // The nursery radar goes quiet; the bedroom one carries on as before
+  nursery.radar.set_silent(true);
+  uint32_t publishes = bedroom.publishes;
+  uint32_t requests = bedroom.radar.requests();
+  node.run(20000);
+  CHECK(bedroom.publishes - publishes == healthy_publishes);
+  CHECK(bedroom.radar.requests() - requests == healthy_requests);
+  CHECK(bedroom.timeouts.state == 0);
+  CHECK(bedroom.uart.unread() == 0);
+  CHECK(nursery.timeouts.state > 0);
+  
+  // And the silent one recovers by itself once it talks again
+  nursery.radar.set_silent(false);
+  nursery.radar.set_register(0x85, 0x82, {66});
+  node.run(10000);
+  CHECK(nursery.heart_rate.state == 66);
+  return finish();
+}
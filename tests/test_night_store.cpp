@@ -0,0 +1,174 @@
+// Night store codec round trip: zigzag and varint edge cases, block rollover with its
+// keyframes and the oldest block dropped, and a synthetic night decoded back exactly.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "c1001_store.h"
+#include "host_test.h"
+
+using namespace esphome;
+using namespace esphome::testing;
+using c1001::C1001NightStore;
+
+struct Record {
+  uint32_t time_s;
+  uint8_t channel;
+  int32_t tenths;
+  
+  bool operator==(const Record &other) const {
+    return this->time_s == other.time_s && this->channel == other.channel && this->tenths == other.tenths;
+  }
+};
+
+// Records into a store and keeps what it should decode to: per block, the keyframes it
+// opens with (the latest value of every channel seen before), then the records themselves
+class Recorder {
+ public:
+  explicit Recorder(uint32_t size) : buffer_(size) { this->store.init(this->buffer_.data(), size); }
+  
+  void record(uint32_t now_s, uint8_t channel, float value, bool change_only = false) {
+    int32_t tenths = lroundf(value * 10.0f);
+    if (change_only && (this->seen_ & (1 << channel)) != 0 && this->latest_[channel] == tenths) {
+      this->store.record_change(now_s, channel, value);
+      return;
+    }
+    
+    uint32_t end_block = this->store.end_block();
+    if (change_only) {
+      this->store.record_change(now_s, channel, value);
+    } else {
+      this->store.record(now_s, channel, value);
+    }
+    if (this->store.end_block() != end_block) {
+      this->blocks_.emplace_back();
+      for (uint8_t i = 0; i < C1001NightStore::MAX_CHANNELS; i++) {
+        if ((this->seen_ & (1 << i)) != 0) {
+          this->blocks_.back().push_back({now_s, i, this->latest_[i]});
+        }
+      }
+    }
+    this->blocks_.back().push_back({now_s, channel, tenths});
+    this->latest_[channel] = tenths;
+    this->seen_ |= 1 << channel;
+  }
+  
+  // Every retained block decodes to exactly what was recorded into it
+  void check_round_trip() {
+    CHECK(this->store.end_block() == this->blocks_.size());
+    uint8_t block[C1001NightStore::BLOCK_SIZE];
+    if (this->store.first_block() > 0) {
+      CHECK(!this->store.read_block(this->store.first_block() - 1, block));
+    }
+    CHECK(!this->store.read_block(this->store.end_block(), block));
+    for (uint32_t sequence = this->store.first_block(); sequence < this->store.end_block(); sequence++) {
+      CHECK(this->store.read_block(sequence, block));
+      std::vector<Record> decoded;
+      uint16_t records = C1001NightStore::decode_block(block, visit, &decoded);
+      CHECK(records == decoded.size());
+      CHECK(decoded == this->blocks_[sequence]);
+    }
+  }
+  
+  C1001NightStore store;
+  
+ protected:
+  static void visit(void *context, uint32_t time_s, uint8_t channel, float value) {
+    static_cast<std::vector<Record> *>(context)->push_back({time_s, channel, (int32_t) lroundf(value * 10.0f)});
+  }
+  
+  std::vector<uint8_t> buffer_;
+  std::vector<std::vector<Record>> blocks_;
+  int32_t latest_[C1001NightStore::MAX_CHANNELS]{};
+  uint8_t seen_{0};
+};
+
+static void edge_cases() {
+  Recorder recorder(4 * C1001NightStore::BLOCK_SIZE);
+  uint32_t now = 1000;
+  // Gaps either side of the escape into a varint, and up to the 5 byte varint
+  const uint32_t gaps[] = {0, 1, 30, 31, 32, 127 + 31, 128 + 31, 100000, 0x7FFFFFFF};
+  for (uint32_t gap : gaps) {
+    now += gap;
+    recorder.record(now, 0, 60.0f);
+  }
+  // Deltas around the zigzag varint byte boundaries, both signs, and the largest swings
+  const float values[] = {0.0f, 0.1f, -0.1f, 6.3f, -6.4f, 6.4f, -6.5f, 0.0f, 819.1f, -819.2f, 1e8f, -1e8f, 0.0f};
+  for (float value : values) {
+    recorder.record(now++, 1, value);
+  }
+  // Every channel, and change-only records that repeat and so aren't stored
+  for (uint8_t channel = 0; channel < C1001NightStore::MAX_CHANNELS; channel++) {
+    recorder.record(now, channel, channel);
+    recorder.record(now + 1, channel, channel, true);
+  }
+  recorder.record(now + 2, 6, 1.0f, true);
+  // Not stored at all
+  recorder.store.record(now, C1001NightStore::MAX_CHANNELS, 1.0f);
+  recorder.store.record(now, 0, NAN);
+  recorder.check_round_trip();
+  CHECK(recorder.store.samples() == 9 + 13 + 7 + 1);
+  
+  // Too small a buffer disables the store
+  C1001NightStore disabled;
+  uint8_t buffer[C1001NightStore::BLOCK_SIZE + 100];
+  disabled.init(buffer, sizeof(buffer));
+  disabled.record(0, 0, 1.0f);
+  CHECK(!disabled.enabled() && disabled.samples() == 0);
+}
+
+static void rollover() {
+  // Three blocks, many times over: blocks fill up in turn, each opens with a keyframe
+  // of every channel, and the oldest is dropped whole
+  Recorder recorder(3 * C1001NightStore::BLOCK_SIZE + 100);
+  CHECK(recorder.store.capacity() == 3 * C1001NightStore::BLOCK_SIZE);
+  uint32_t seed = 1;
+  uint32_t now = 0;
+  for (uint32_t i = 0; i < 2000; i++) {
+    seed = seed * 1103515245 + 12345;
+    now += (seed >> 8) % 4 == 0 ? (seed >> 12) % 1000 : 1;
+    recorder.record(now, (seed >> 16) % 3, (float) ((int32_t) (seed >> 20) % 4000 - 2000) / 10.0f);
+  }
+  CHECK(recorder.store.first_block() > 10);
+  CHECK(recorder.store.used() == recorder.store.capacity());
+  recorder.check_round_trip();
+}
+
+static void night() {
+  // Eight hours: vitals every few seconds as a slow random walk, sleep state and in bed as
+  // change-only channels, with a few gaps where the radar lost the person
+  Recorder recorder(128 * 1024);
+  uint32_t seed = 7;
+  float heart_rate = 62.0f;
+  float respiration = 14.0f;
+  uint8_t stage = 2;
+  for (uint32_t t = 0; t < 8 * 3600; t += 3) {
+    seed = seed * 1103515245 + 12345;
+    if (t % 3600 > 3500) {
+      continue;
+    }
+    heart_rate += ((int32_t) (seed >> 16) % 11 - 5) / 10.0f;
+    respiration += ((int32_t) (seed >> 20) % 5 - 2) / 10.0f;
+    if ((seed >> 8) % 600 == 0) {
+      stage = (seed >> 12) % 3;
+    }
+    recorder.record(t, 0, heart_rate);
+    recorder.record(t, 1, respiration);
+    recorder.record(t, 2, stage, true);
+    recorder.record(t, 3, 1.0f, true);
+  }
+  CHECK(recorder.store.first_block() == 0);
+  recorder.check_round_trip();
+  printf("Synthetic night: %u samples, %u bytes encoded, %.2f bytes/sample (9 unencoded)\n",
+         recorder.store.samples(), recorder.store.encoded_bytes(),
+         (double) recorder.store.encoded_bytes() / recorder.store.samples());
+}
+
+int main() {
+  edge_cases();
+  rollover();
+  night();
+  return finish();
+}
@@ -0,0 +1,137 @@
+// Frame parser at its limits, under ASan and UBSan: the longest frame it accepts, headers
+// announcing more than it can hold, frames cut off at every position, and random noise
+// with real frames buried in it.
+
+#include <cstdint>
+#include <vector>
+
+#include "c1001_protocol.h"
+#include "host_test.h"
+#include "radar_emulator.h"
+
+using namespace esphome;
+using namespace esphome::testing;
+using c1001::C1001FrameParser;
+
+// Feed bytes one at a time and return every frame the parser yields, whole
+static std::vector<std::vector<uint8_t>> parse(C1001FrameParser &parser, const std::vector<uint8_t> &bytes) {
+  std::vector<std::vector<uint8_t>> frames;
+  for (uint8_t byte : bytes) {
+    parser.feed(byte);
+    while (parser.next()) {
+      c1001::C1001FrameView frame = parser.frame();
+      CHECK(parser.payload().size() + 9 == frame.size());
+      frames.emplace_back(frame.data(), frame.data() + frame.size());
+    }
+  }
+  return frames;
+}
+
+static std::vector<uint8_t> concat(std::vector<uint8_t> a, const std::vector<uint8_t> &b) {
+  a.insert(a.end(), b.begin(), b.end());
+  return a;
+}
+
+// Small deterministic generator, so a failure reproduces
+static uint32_t random_state = 12345;
+static uint32_t random_next() {
+  random_state = random_state * 1103515245 + 12345;
+  return random_state >> 8;
+}
+
+static void longest_frame() {
+  // Header bytes inside the data are just data
+  std::vector<uint8_t> data;
+  for (uint16_t i = 0; i < c1001::C1001_MAX_DATA_LEN; i++) {
+    data.push_back(i % 2 == 0 ? 0x53 : 0x59);
+  }
+  std::vector<uint8_t> frame = RadarEmulator::frame(0x85, 0x02, data);
+  C1001FrameParser parser;
+  auto frames = parse(parser, frame);
+  CHECK(frames.size() == 1 && frames[0] == frame);
+  CHECK(frames[0].size() == 9 + c1001::C1001_MAX_DATA_LEN);
+  CHECK(parser.rejected() == 0);
+  CHECK(parser.idle());
+}
+
+static void oversize_frames() {
+  // One byte too long, and the longest length the header can announce. Neither is
+  // assembled; the frame after them still is.
+  std::vector<uint8_t> valid = RadarEmulator::frame(0x81, 0x02, {18});
+  std::vector<uint8_t> too_long =
+      RadarEmulator::frame(0x85, 0x02, std::vector<uint8_t>(c1001::C1001_MAX_DATA_LEN + 1, 0x11));
+  std::vector<uint8_t> huge = {0x53, 0x59, 0x85, 0x02, 0xFF, 0xFF};
+  for (int i = 0; i < 300; i++) {
+    huge.push_back(0xAA);
+  }
+  C1001FrameParser parser;
+  auto frames = parse(parser, concat(concat(too_long, huge), valid));
+  CHECK(frames.size() == 1 && frames[0] == valid);
+  CHECK(parser.rejected() >= 2);
+  CHECK(parser.checksum_errors() == 0);
+}
+
+static void truncated_frames() {
+  // Cut a frame after every byte but its last; the two frames after it are recovered, and
+  // the cut one counts as partial rather than as a checksum failure
+  std::vector<uint8_t> cut = RadarEmulator::frame(0x84, 0x8D, {1, 1, 15, 70, 2, 10, 20, 0});
+  std::vector<uint8_t> first = RadarEmulator::frame(0x85, 0x02, {71});
+  std::vector<uint8_t> second = RadarEmulator::frame(0x81, 0x02, {18});
+  for (size_t len = 1; len < cut.size(); len++) {
+    C1001FrameParser parser;
+    std::vector<uint8_t> bytes(cut.begin(), cut.begin() + len);
+    auto frames = parse(parser, concat(concat(bytes, first), second));
+    CHECK(frames.size() == 2 && frames[0] == first && frames[1] == second);
+    CHECK(parser.checksum_errors() == 0);
+    CHECK(parser.partial_frames() == 1);
+    CHECK(parser.idle());
+  }
+}
+
+static void noise() {
+  // Runs of noise, rich in header bytes, each followed by a real frame of random size. Every
+  // real frame comes out, in order; a run that happens to parse as a frame may add to them.
+  C1001FrameParser parser;
+  std::vector<std::vector<uint8_t>> sent;
+  std::vector<uint8_t> bytes;
+  for (int i = 0; i < 5000; i++) {
+    uint32_t noise_len = random_next() % 64;
+    for (uint32_t j = 0; j < noise_len; j++) {
+      uint32_t r = random_next();
+      bytes.push_back(r % 4 == 0 ? 0x53 : r % 4 == 1 ? 0x59 : (r >> 8) & 0xFF);
+    }
+    std::vector<uint8_t> data(random_next() % (c1001::C1001_MAX_DATA_LEN + 1));
+    for (auto &byte : data) {
+      byte = random_next() & 0xFF;
+    }
+    sent.push_back(RadarEmulator::frame(random_next() & 0xFF, random_next() & 0xFF, data));
+    bytes.insert(bytes.end(), sent.back().begin(), sent.back().end());
+  }
+  auto frames = parse(parser, bytes);
+  size_t found = 0;
+  for (const auto &frame : frames) {
+    if (found < sent.size() && frame == sent[found]) {
+      found++;
+    }
+  }
+  CHECK(found == sent.size());
+  CHECK(parser.frames() == frames.size());
+  
+  // Pure noise never overruns the parser's buffers
+  C1001FrameParser noise_parser;
+  for (int i = 0; i < 1000000; i++) {
+    uint32_t r = random_next();
+    noise_parser.feed(r % 3 == 0 ? 0x53 : r % 3 == 1 ? 0x59 : (r >> 8) & 0xFF);
+    while (noise_parser.next()) {
+    }
+  }
+  CHECK(noise_parser.rejected() > 0);
+}
+
+int main() {
+  longest_frame();
+  oversize_frames();
+  truncated_frames();
+  noise();
+  return finish();
+}
@@ -0,0 +1,44 @@
+// Sensors sharing a register poll it at the fastest of their intervals, whether those
+// were given explicitly or left to the default.
+
+#include "host_node.h"
+#include "host_test.h"
+
+using namespace esphome;
+using namespace esphome::testing;
+
+int main() {
+  FakeUart uart;
+  RadarEmulator radar(&uart);
+  radar.set_register(0x84, 0x8D, {1, 1, 15, 70, 2, 10, 20, 0});  // Sleep composite
+  radar.set_register(0x85, 0x82, {72});                          // Heart rate
+  
+  c1001::C1001Component radar_component;
+  sensor::Sensor average_respiration("average_respiration");
+  sensor::Sensor turnover_count("turnover_count");
+  sensor::Sensor heart_rate("heart_rate");
+  radar_component.set_uart_parent(&uart);
+  radar_component.set_update_interval(5000);
+  radar_component.set_push_reports(false);
+  // Composite: 5 minutes explicitly for one sensor, the default (3 x 5 s) for the other
+  radar_component.set_average_respiration_sensor(&average_respiration);
+  radar_component.set_turnover_count_sensor(&turnover_count);
+  radar_component.add_polled_metric(c1001::METRIC_SLEEP_COMPOSITE, 300000);
+  radar_component.add_polled_metric(c1001::METRIC_SLEEP_COMPOSITE, 0);
+  // Heart rate: the default (5 s) loses to an explicit 2 s, in either order
+  radar_component.set_heart_rate_sensor(&heart_rate);
+  radar_component.add_polled_metric(c1001::METRIC_HEART_RATE, 0);
+  radar_component.add_polled_metric(c1001::METRIC_HEART_RATE, 2000);
+  
+  HostNode node;
+  node.add(&radar_component, &radar);
+  CHECK(node.start());
+  
+  uint32_t composite_polls = radar.requests(0x84, 0x8D);
+  uint32_t heart_rate_polls = radar.requests(0x85, 0x82);
+  node.run(60000);
+  CHECK(radar.requests(0x84, 0x8D) - composite_polls == 4);
+  CHECK(radar.requests(0x85, 0x82) - heart_rate_polls == 30);
+  CHECK(turnover_count.state == 2);
+  return finish();
+}
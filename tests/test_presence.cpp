@@ -0,0 +1,137 @@
+// person_detected follows the presence register's 0/1 on every path: poll replies, push
+// reports (0x80:0x01) and the sleep composite; an empty room starts the vacant watch.
+// Polled "nobody" samples are debounced, pushed ones are not.
+
+#include "host_node.h"
+#include "host_test.h"
+
+using namespace esphome;
+using namespace esphome::testing;
+
+static void polled_and_pushed() {
+  FakeUart uart;
+  RadarEmulator radar(&uart);
+  radar.set_register(0x80, 0x81, {0});   // Presence
+  radar.set_register(0x85, 0x82, {72});  // Heart rate
+  
+  c1001::C1001Component radar_component;
+  binary_sensor::BinarySensor person_detected("person_detected");
+  sensor::Sensor presence("presence");
+  sensor::Sensor heart_rate("heart_rate");
+  radar_component.set_uart_parent(&uart);
+  radar_component.set_update_interval(1000);
+  radar_component.set_person_detected_binary_sensor(&person_detected);
+  radar_component.set_presence_sensor(&presence);
+  radar_component.set_heart_rate_sensor(&heart_rate);
+  radar_component.add_polled_metric(c1001::METRIC_PRESENCE, 0);
+  radar_component.add_polled_metric(c1001::METRIC_HEART_RATE, 0);
+  radar_component.set_adaptive_polling(5000, 3000);
+  
+  HostNode node;
+  node.add(&radar_component, &radar);
+  CHECK(node.start());
+  
+  // Polled: 0 is nobody, 1 is someone
+  node.run(1500);
+  CHECK(person_detected.has_state());
+  CHECK(!person_detected.state);
+  CHECK(presence.state == 0);
+  radar.set_register(0x80, 0x81, {1});
+  node.run(1500);
+  CHECK(person_detected.state);
+  CHECK(presence.state == 1);
+  radar.set_register(0x80, 0x81, {0});
+  node.run(2500);
+  CHECK(!person_detected.state);
+  
+  // Nobody there: after vacant_after only presence is polled
+  node.run(4000);
+  uint32_t heart_rate_polls = radar.requests(0x85, 0x82);
+  node.run(5000);
+  CHECK(radar.requests(0x85, 0x82) == heart_rate_polls);
+  
+  // Pushed 1: detected at once, and full polling resumes
+  radar.push(0x80, 0x01, {1});
+  node.run(5);
+  CHECK(person_detected.state);
+  node.run(1000);
+  CHECK(radar.requests(0x85, 0x82) > heart_rate_polls);
+  
+  // Pushed 0: cleared at once
+  radar.push(0x80, 0x01, {0});
+  node.run(5);
+  CHECK(!person_detected.state);
+  CHECK(presence.state == 0);
+}
+
+static void composite() {
+  FakeUart uart;
+  RadarEmulator radar(&uart);
+  radar.set_register(0x84, 0x8D, {1, 1, 15, 70, 2, 10, 20, 0});  // Sleep composite, someone there
+  
+  c1001::C1001Component radar_component;
+  binary_sensor::BinarySensor person_detected("person_detected");
+  radar_component.set_uart_parent(&uart);
+  radar_component.set_update_interval(1000);
+  radar_component.set_composite_first(true);
+  radar_component.set_person_detected_binary_sensor(&person_detected);
+  radar_component.add_polled_metric(c1001::METRIC_PRESENCE, 0);
+  
+  HostNode node;
+  node.add(&radar_component, &radar);
+  CHECK(node.start());
+  node.run(1500);
+  CHECK(radar.requests(0x80, 0x81) == 0);
+  CHECK(person_detected.state);
+  radar.set_register(0x84, 0x8D, {0, 3, 0, 0, 0, 0, 0, 0});
+  node.run(2500);
+  CHECK(!person_detected.state);
+}
+
+static void debounce() {
+  FakeUart uart;
+  RadarEmulator radar(&uart);
+  radar.set_register(0x80, 0x81, {1});
+  
+  c1001::C1001Component radar_component;
+  binary_sensor::BinarySensor person_detected("person_detected");
+  sensor::Sensor presence_latency("presence_latency");
+  uint32_t cleared = 0;
+  person_detected.add_on_state_callback([&cleared](bool state) { cleared += !state; });
+  radar_component.set_uart_parent(&uart);
+  radar_component.set_update_interval(1000);
+  radar_component.set_push_reports(false);
+  radar_component.set_person_detected_binary_sensor(&person_detected);
+  radar_component.set_presence_latency_sensor(&presence_latency);
+  radar_component.set_presence_clear_samples(3);
+  radar_component.add_polled_metric(c1001::METRIC_PRESENCE, 0);
+  
+  HostNode node;
+  node.add(&radar_component, &radar);
+  CHECK(node.start());
+  node.run(1500);
+  CHECK(person_detected.state);
+  
+  // Two polled misses in a row are not enough to clear it
+  radar.set_register(0x80, 0x81, {0});
+  uint32_t polls = radar.requests(0x80, 0x81);
+  CHECK(node.run_until([&radar, polls]() { return radar.requests(0x80, 0x81) == polls + 2; }, 3000));
+  radar.set_register(0x80, 0x81, {1});
+  node.run(3000);
+  CHECK(person_detected.state);
+  CHECK(cleared == 0);
+  
+  // The third clears it; the edge latency goes back to before the first miss
+  radar.set_register(0x80, 0x81, {0});
+  node.run(3500);
+  CHECK(!person_detected.state);
+  CHECK(cleared == 1);
+  CHECK(presence_latency.state >= 2000);
+}
+
+int main() {
+  polled_and_pushed();
+  composite();
+  debounce();
+  return finish();
+}
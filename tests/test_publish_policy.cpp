@@ -0,0 +1,50 @@
+// Change-only publishing: values inside the deadband are held back and counted, a move
+// beyond it goes out, and the heartbeat sends the last value again even when no new
+// sample arrives.
+
+#include "host_node.h"
+#include "host_test.h"
+
+using namespace esphome;
+using namespace esphome::testing;
+
+int main() {
+  FakeUart uart;
+  RadarEmulator radar(&uart);
+  
+  c1001::C1001Component radar_component;
+  sensor::Sensor heart_rate("heart_rate");
+  sensor::Sensor suppressed("suppressed_publishes");
+  radar_component.set_uart_parent(&uart);
+  radar_component.set_update_interval(5000);
+  radar_component.set_heart_rate_sensor(&heart_rate);
+  radar_component.set_suppressed_publishes_sensor(&suppressed);
+  radar_component.set_publish_policy(&heart_rate, 1.0f, 60000);
+  uint32_t published = 0;
+  heart_rate.add_on_state_callback([&published](float) { published++; });
+  
+  HostNode node;
+  node.add(&radar_component, &radar);
+  CHECK(node.start());
+  
+  // Heart rate arrives as push reports only; nothing polls it
+  const uint8_t values[] = {72, 72, 73, 72, 75};
+  for (uint8_t value : values) {
+    radar.push(0x85, 0x02, {value});
+    node.run(1000);
+  }
+  CHECK(published == 2);
+  CHECK_NEAR(heart_rate.state, 75.0, 0.01);
+  node.run(5000);
+  CHECK(suppressed.state == 3);
+  
+  // Then the reports stop. The last value goes out again once per heartbeat, on the update
+  // after it has passed, without counting as suppressed.
+  node.run(60000);
+  CHECK(published == 3);
+  node.run(60000);
+  CHECK(published == 4);
+  CHECK_NEAR(heart_rate.state, 75.0, 0.01);
+  CHECK(suppressed.state == 3);
+  return finish();
+}
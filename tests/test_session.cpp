@@ -0,0 +1,165 @@
+// Sleep session tracker: a night with a trip to the bathroom in it, totals and onset and
+// awakenings, sessions too short to report, the hypnogram folding past MAX_RUNS, and the
+// summary as the component publishes it.
+
+#include <cstring>
+
+#include "c1001_session.h"
+#include "host_node.h"
+#include "host_test.h"
+
+using namespace esphome;
+using namespace esphome::testing;
+using c1001::C1001SleepSession;
+
+static const uint8_t DEEP = C1001SleepSession::STAGE_DEEP;
+static const uint8_t LIGHT = C1001SleepSession::STAGE_LIGHT;
+static const uint8_t AWAKE = C1001SleepSession::STAGE_AWAKE;
+
+// Feed a state every minute from from_s up to (not including) to_s, as the samples would
+static bool hold(C1001SleepSession &session, uint32_t from_s, uint32_t to_s, bool in_bed, uint8_t stage) {
+  bool ended = false;
+  for (uint32_t t = from_s; t < to_s; t += 60) {
+    ended |= session.update(t * 1000, in_bed, stage);
+  }
+  return ended;
+}
+
+static void night() {
+  C1001SleepSession session;
+  session.set_timing(15 * 60 * 1000, 30 * 60 * 1000);
+  
+  // Nothing starts while the bed is empty
+  CHECK(!hold(session, 0, 600, false, AWAKE));
+  CHECK(!session.active());
+  
+  // 10 min awake, 30 light, 20 deep, then awake; a 5 min trip out of bed doesn't split the
+  // night and counts as awake; 30 min light, then out of bed for good
+  CHECK(!hold(session, 600, 1200, true, AWAKE));
+  CHECK(session.active());
+  CHECK(!hold(session, 1200, 3000, true, LIGHT));
+  CHECK(!hold(session, 3000, 4200, true, DEEP));
+  CHECK(!hold(session, 4200, 4500, true, AWAKE));
+  CHECK(!hold(session, 4500, 4800, false, AWAKE));
+  CHECK(session.active());
+  CHECK(!hold(session, 4800, 6600, true, LIGHT));
+  
+  // The session ends end_after after getting up, dated back to getting up
+  CHECK(!hold(session, 6600, 6600 + 15 * 60, false, AWAKE));
+  CHECK(session.active());
+  CHECK(session.update((6600 + 15 * 60) * 1000, false, AWAKE));
+  CHECK(!session.active());
+  
+  const C1001SleepSession::Summary &summary = session.summary();
+  CHECK(summary.start == 600 * 1000);
+  CHECK(summary.duration_s == 6000);
+  CHECK(summary.stage_s[DEEP] == 1200);
+  CHECK(summary.stage_s[LIGHT] == 3600);
+  CHECK(summary.stage_s[AWAKE] == 1200);
+  CHECK(summary.sleep_onset_s == 600);
+  CHECK(summary.awakenings == 1);
+  CHECK(summary.transitions == 4);
+  CHECK(summary.runs == 5 && !summary.truncated);
+  char hypnogram[64];
+  CHECK(session.format_hypnogram(hypnogram, sizeof(hypnogram)) == strlen("W10 L30 D20 W10 L30"));
+  CHECK(strcmp(hypnogram, "W10 L30 D20 W10 L30") == 0);
+  
+  // Cut short, the hypnogram says so
+  CHECK(session.format_hypnogram(hypnogram, 12) == strlen("W10 L30..."));
+  CHECK(strcmp(hypnogram, "W10 L30...") == 0);
+}
+
+static void too_short() {
+  // 20 minutes in bed is under min_duration: it ends, but isn't reported
+  C1001SleepSession session;
+  session.set_timing(15 * 60 * 1000, 30 * 60 * 1000);
+  CHECK(!hold(session, 0, 1200, true, LIGHT));
+  CHECK(!hold(session, 1200, 1200 + 16 * 60, false, AWAKE));
+  CHECK(!session.active());
+  
+  // Never slept: onset is the whole session
+  CHECK(!hold(session, 10000, 10000 + 3600, true, AWAKE));
+  CHECK(hold(session, 10000 + 3600, 10000 + 3600 + 16 * 60, false, AWAKE));
+  CHECK(session.summary().sleep_onset_s == 3600);
+  CHECK(session.summary().awakenings == 0);
+}
+
+static void folding() {
+  // 100 stage changes: the first MAX_RUNS - 1 runs stay as they were and the last one holds
+  // everything after, while the stage totals stay exact
+  C1001SleepSession session;
+  session.set_timing(60 * 1000, 60 * 1000);
+  uint32_t t = 0;
+  for (int i = 0; i < 101; i++) {
+    CHECK(!hold(session, t, t + 120, true, i % 2 == 0 ? LIGHT : DEEP));
+    t += 120;
+  }
+  CHECK(hold(session, t, t + 180, false, AWAKE));
+  const C1001SleepSession::Summary &summary = session.summary();
+  CHECK(summary.runs == C1001SleepSession::MAX_RUNS);
+  CHECK(summary.truncated);
+  CHECK(summary.transitions == 100);
+  CHECK(summary.stage_s[LIGHT] == 51 * 120 && summary.stage_s[DEEP] == 50 * 120);
+  CHECK(summary.duration_s == 101 * 120);
+  uint32_t hypnogram_s = 0;
+  for (uint8_t i = 0; i < summary.runs; i++) {
+    hypnogram_s += session.run(i).seconds;
+    if (i + 1 < summary.runs) {
+      CHECK(session.run(i).seconds == 120);
+    }
+  }
+  CHECK(hypnogram_s == summary.duration_s);
+}
+
+static void published() {
+  // The component's summary: in bed, 1 min awake, 2 light, 2 deep, then out. Efficiency is
+  // the asleep share of the time in bed.
+  FakeUart uart;
+  RadarEmulator radar(&uart);
+  radar.set_register(0x84, 0x81, {0});  // In bed
+  radar.set_register(0x84, 0x82, {3});  // Sleep state
+  
+  c1001::C1001Component radar_component;
+  sensor::Sensor duration("session_duration");
+  sensor::Sensor efficiency("session_efficiency");
+  sensor::Sensor onset("session_sleep_onset");
+  sensor::Sensor awakenings("session_awakenings");
+  radar_component.set_uart_parent(&uart);
+  radar_component.set_update_interval(10000);
+  radar_component.set_push_reports(false);
+  radar_component.set_sleep_session(60000, 120000);
+  radar_component.set_session_duration_sensor(&duration);
+  radar_component.set_session_efficiency_sensor(&efficiency);
+  radar_component.set_session_sleep_onset_sensor(&onset);
+  radar_component.set_session_awakenings_sensor(&awakenings);
+  radar_component.add_polled_metric(c1001::METRIC_IN_BED, 0);
+  radar_component.add_polled_metric(c1001::METRIC_SLEEP_STATE, 0);
+  
+  HostNode node;
+  node.add(&radar_component, &radar);
+  CHECK(node.start());
+  radar.set_register(0x84, 0x81, {1});
+  radar.set_register(0x84, 0x82, {AWAKE});
+  node.run(60000);
+  radar.set_register(0x84, 0x82, {LIGHT});
+  node.run(120000);
+  radar.set_register(0x84, 0x82, {DEEP});
+  node.run(120000);
+  CHECK(!duration.has_state());
+  radar.set_register(0x84, 0x81, {0});
+  radar.set_register(0x84, 0x82, {AWAKE});
+  node.run(90000);
+  CHECK(duration.has_state());
+  CHECK_NEAR(duration.state, 5.0, 0.2);
+  CHECK_NEAR(efficiency.state, 80.0, 4.0);
+  CHECK_NEAR(onset.state, 1.0, 0.2);
+  CHECK(awakenings.state == 0);
+}
+
+int main() {
+  night();
+  too_short();
+  folding();
+  published();
+  return finish();
+}
@@ -0,0 +1,147 @@
+// Rolling statistics against a brute-force recomputation over the same window: samples
+// sliding out bucket by bucket, a gap longer than the window, and a bucket whose sample
+// count saturates.
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "c1001_stats.h"
+#include "host_test.h"
+
+using namespace esphome;
+using namespace esphome::testing;
+using c1001::C1001RollingStats;
+
+struct Sample {
+  uint32_t time;
+  float value;
+};
+
+// Small deterministic generator, so a failure reproduces
+static uint32_t random_state = 2024;
+static uint32_t random_next() {
+  random_state = random_state * 1103515245 + 12345;
+  return random_state >> 8;
+}
+
+// The summary as it should be: every sample whose bucket is among the last BUCKETS
+static bool brute_force(const std::vector<Sample> &samples, uint32_t bucket_ms, uint32_t now,
+                        C1001RollingStats::Summary &out) {
+  std::vector<float> values;
+  for (const Sample &sample : samples) {
+    if (now / bucket_ms - sample.time / bucket_ms < C1001RollingStats::BUCKETS) {
+      values.push_back(sample.value);
+    }
+  }
+  if (values.empty()) {
+    return false;
+  }
+  double sum = 0;
+  out.min = values[0];
+  out.max = values[0];
+  for (float value : values) {
+    sum += value;
+    out.min = std::fmin(out.min, value);
+    out.max = std::fmax(out.max, value);
+  }
+  double mean = sum / values.size();
+  double m2 = 0;
+  for (float value : values) {
+    m2 += (value - mean) * (value - mean);
+  }
+  out.count = values.size();
+  out.mean = mean;
+  out.stddev = values.size() > 1 ? std::sqrt(m2 / (values.size() - 1)) : 0.0;
+  return true;
+}
+
+static void compare(const C1001RollingStats &stats, const std::vector<Sample> &samples, uint32_t bucket_ms,
+                    uint32_t now) {
+  C1001RollingStats::Summary actual{};
+  C1001RollingStats::Summary expected{};
+  bool has_actual = stats.summary(now, actual);
+  CHECK(has_actual == brute_force(samples, bucket_ms, now, expected));
+  if (!has_actual) {
+    return;
+  }
+  CHECK(actual.count == expected.count);
+  CHECK(actual.min == expected.min);
+  CHECK(actual.max == expected.max);
+  CHECK_NEAR(actual.mean, expected.mean, 0.001);
+  CHECK_NEAR(actual.stddev, expected.stddev, 0.002);
+}
+
+static void sliding() {
+  // A one-minute window in 5 s buckets, samples every 0-3 s
+  C1001RollingStats stats;
+  stats.set_window(60000);
+  CHECK(stats.window() == 60000);
+  const uint32_t bucket_ms = 60000 / C1001RollingStats::BUCKETS;
+  std::vector<Sample> samples;
+  uint32_t now = 1000000;
+  for (int i = 0; i < 3000; i++) {
+    now += random_next() % 3000;
+    float value = 40.0f + (random_next() % 800) / 10.0f;
+    stats.add(now, value);
+    samples.push_back({now, value});
+    compare(stats, samples, bucket_ms, now);
+  }
+  
+  // No more samples: the window empties a bucket at a time
+  uint32_t last = now;
+  for (; now < last + 70000; now += 1000) {
+    compare(stats, samples, bucket_ms, now);
+  }
+  C1001RollingStats::Summary summary;
+  CHECK(!stats.summary(now, summary));
+  
+  // After a gap longer than the window only the new samples count, even where they land in
+  // slots that held old ones
+  now += 600000;
+  for (int i = 0; i < 30; i++) {
+    now += 1000;
+    stats.add(now, 60.0f + i);
+    samples.push_back({now, 60.0f + i});
+    compare(stats, samples, bucket_ms, now);
+  }
+  CHECK(stats.summary(now, summary) && summary.count == 30);
+  
+  // Changing the window starts over
+  stats.set_window(120000);
+  CHECK(!stats.summary(now, summary));
+}
+
+static void saturation() {
+  // 200000 samples in one bucket, alternating 10 and 20, with one 0 and one 30 among them.
+  // The count stops at 65535, but the mean and spread stay those of the input.
+  C1001RollingStats stats;
+  stats.set_window(12000);
+  for (uint32_t i = 0; i < 200000; i++) {
+    float value = i % 2 == 0 ? 10.0f : 20.0f;
+    if (i == 1000) {
+      value = 0.0f;
+    } else if (i == 150001) {
+      value = 30.0f;
+    }
+    stats.add(5000, value);
+  }
+  C1001RollingStats::Summary summary;
+  CHECK(stats.summary(5500, summary));
+  CHECK(summary.count == UINT16_MAX);
+  CHECK(summary.min == 0.0f && summary.max == 30.0f);
+  CHECK_NEAR(summary.mean, 15.0, 0.1);
+  CHECK_NEAR(summary.stddev, 5.0, 0.1);
+  
+  // Merged with a small bucket, the saturated one weighs in at its capped count
+  stats.add(6500, 100.0f);
+  CHECK(stats.summary(6500, summary));
+  CHECK(summary.count == UINT16_MAX + 1u);
+  CHECK_NEAR(summary.mean, (15.0 * UINT16_MAX + 100.0) / (UINT16_MAX + 1.0), 0.1);
+}
+
+int main() {
+  sliding();
+  saturation();
+  return finish();
+}
@@ -0,0 +1,193 @@
+// Host benchmark of the protocol hot paths, built without sanitizers. Times request
+// encoding, the checksum, the raw -> BPM calibration lookups, the frame parser on its own
+// and the whole parse -> dispatch -> publish path of a configured component, and counts
+// heap allocations for each with a global operator new hook. None of them may allocate:
+// the exit code is 1 if one did.
+//
+//   c1001_bench [rounds]       (6 push reports per round, 20000 rounds by default)
+
+#include "host_node.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+using namespace esphome;
+using namespace esphome::testing;
+
+static std::atomic<uint64_t> allocations{0};
+
+void *operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  void *ptr = malloc(size != 0 ? size : 1);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete[](void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { free(ptr); }
+
+struct Result {
+  double ns_per_op;
+  double allocations_per_op;
+};
+
+// One round: the push reports a sleeping person produces
+static std::vector<uint8_t> make_round() {
+  std::vector<uint8_t> round;
+  const std::vector<std::vector<uint8_t>> frames = {
+      RadarEmulator::frame(0x85, 0x02, {72}),                        // Heart rate
+      RadarEmulator::frame(0x81, 0x02, {18}),                        // Respiration
+      RadarEmulator::frame(0x80, 0x01, {1}),                         // Presence
+      RadarEmulator::frame(0x84, 0x01, {1}),                         // In bed
+      RadarEmulator::frame(0x84, 0x02, {1}),                         // Sleep state
+      RadarEmulator::frame(0x84, 0x0D, {1, 1, 15, 70, 2, 10, 20, 0}),  // Sleep composite
+  };
+  for (const auto &frame : frames) {
+    round.insert(round.end(), frame.begin(), frame.end());
+  }
+  return round;
+}
+
+static const uint32_t FRAMES_PER_ROUND = 6;
+
+template<typename Body> static Result measure(uint32_t ops, Body body) {
+  uint64_t allocations_before = allocations.load();
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  uint64_t allocated = allocations.load() - allocations_before;
+  return Result{std::chrono::duration<double, std::nano>(elapsed).count() / ops, (double) allocated / ops};
+}
+
+int main(int argc, char **argv) {
+  uint32_t rounds = argc > 1 ? (uint32_t) strtoul(argv[1], nullptr, 10) : 20000;
+  uint32_t frames = rounds * FRAMES_PER_ROUND;
+  std::vector<uint8_t> round = make_round();
+  volatile uint32_t sink = 0;
+  
+  // Request encoding, with inputs the compiler can't fold
+  volatile uint8_t con = 0x85;
+  volatile uint8_t cmd = 0x82;
+  Result encode = measure(frames, [&]() {
+    for (uint32_t i = 0; i < frames; i++) {
+      c1001::C1001Frame frame = c1001::make_c1001_request(con, cmd, (uint8_t) i);
+      sink = sink + frame.bytes[7];
+    }
+  });
+  
+  // Checksum over the header and data of the largest frame the parser accepts
+  uint8_t checksum_frame[6 + c1001::C1001_MAX_DATA_LEN];
+  for (uint8_t i = 0; i < sizeof(checksum_frame); i++) {
+    checksum_frame[i] = i * 31;
+  }
+  Result checksum = measure(frames, [&]() {
+    for (uint32_t i = 0; i < frames; i++) {
+      checksum_frame[0] = (uint8_t) i;
+      sink = sink + c1001::c1001_checksum(checksum_frame, sizeof(checksum_frame));
+    }
+  });
+  
+  // Raw -> BPM lookups in the default calibration tables, respiration and heart rate per op
+  const float *respiration_table = c1001::C1001_DEFAULT_RESPIRATION.bpm;
+  const float *heart_rate_table = c1001::C1001_DEFAULT_HEART_RATE.bpm;
+  Result scale = measure(frames, [&]() {
+    for (uint32_t i = 0; i < frames; i++) {
+      sink = sink + (uint32_t) respiration_table[(uint8_t) i] + (uint32_t) heart_rate_table[(uint8_t) i];
+    }
+  });
+  
+  // Parser only
+  c1001::C1001FrameParser parser;
+  Result parse = measure(frames, [&]() {
+    for (uint32_t r = 0; r < rounds; r++) {
+      for (uint8_t byte : round) {
+        parser.feed(byte);
+        while (parser.next()) {
+          sink = sink + parser.payload()[0];
+        }
+      }
+    }
+  });
+  
+  // The component as a typical sleep node configures it, with the data arriving as push reports
+  FakeUart uart;
+  RadarEmulator radar(&uart);
+  c1001::C1001Component component;
+  sensor::Sensor heart_rate("heart_rate"), respiration("respiration"), in_bed("in_bed"), sleep_state("sleep_state");
+  sensor::Sensor average_heart_rate("average_heart_rate"), turnover_count("turnover_count");
+  sensor::Sensor heart_rate_mean("heart_rate_mean"), session_duration("session_duration");
+  binary_sensor::BinarySensor person_detected("person_detected");
+  component.set_uart_parent(&uart);
+  component.set_heart_rate_sensor(&heart_rate);
+  component.set_respiration_sensor(&respiration);
+  component.set_in_bed_sensor(&in_bed);
+  component.set_sleep_state_sensor(&sleep_state);
+  component.set_average_heart_rate_sensor(&average_heart_rate);
+  component.set_turnover_count_sensor(&turnover_count);
+  component.set_person_detected_binary_sensor(&person_detected);
+  component.set_session_duration_sensor(&session_duration);
+  component.set_filter(c1001::METRIC_HEART_RATE, 5, 15.0f);
+  component.set_filter_ema(c1001::METRIC_HEART_RATE, 0.3f);
+  component.add_statistics(c1001::METRIC_HEART_RATE, 600000, nullptr, &heart_rate_mean, nullptr, nullptr);
+  component.set_publish_policy(&respiration, 0.5f, 60000);
+  component.set_night_store_size(8192);
+  component.set_capture_size(4096);
+  HostNode node;
+  node.add(&component, &radar);
+  uint64_t setup_allocations = allocations.load();
+  if (!node.start()) {
+    fprintf(stderr, "Component didn't finish initializing\n");
+    return 2;
+  }
+  setup_allocations = allocations.load() - setup_allocations;
+  
+  uint32_t published = 0;
+  heart_rate.add_on_state_callback([&published](float) { published++; });
+  std::vector<uint8_t> stream;
+  stream.reserve(round.size() * 100);
+  for (uint8_t i = 0; i < 100; i++) {
+    stream.insert(stream.end(), round.begin(), round.end());
+  }
+  // Queue outside the timed region, 100 rounds at a time, then let loop() drain the UART
+  Result dispatch{0, 0};
+  for (uint32_t done = 0; done < rounds; done += 100) {
+    uint32_t batch = rounds - done < 100 ? rounds - done : 100;
+    uart.send(std::vector<uint8_t>(stream.begin(), stream.begin() + batch * round.size()));
+    Result batch_result = measure(batch * FRAMES_PER_ROUND, [&]() {
+      while (uart.unread() > 0) {
+        component.loop();
+      }
+    });
+    dispatch.ns_per_op += batch_result.ns_per_op * batch;
+    dispatch.allocations_per_op += batch_result.allocations_per_op * batch;
+  }
+  dispatch.ns_per_op /= rounds;
+  dispatch.allocations_per_op /= rounds;
+  
+  printf("Benchmark (%u ops per case, ns/op; setup made %llu allocations):\n", frames,
+         (unsigned long long) setup_allocations);
+  printf("  Encode request: %.1f (%.2f allocations/op)\n", encode.ns_per_op, encode.allocations_per_op);
+  printf("  Checksum (%u bytes): %.1f (%.2f allocations/op)\n", (unsigned) sizeof(checksum_frame),
+         checksum.ns_per_op, checksum.allocations_per_op);
+  printf("  Calibrate respiration + heart rate: %.1f (%.2f allocations/op)\n", scale.ns_per_op,
+         scale.allocations_per_op);
+  printf("  Parse: %.0f per frame (%u frames parsed, %.2f allocations/frame)\n", parse.ns_per_op, parser.frames(),
+         parse.allocations_per_op);
+  printf("  Parse + dispatch + publish: %.0f per frame (%u heart rate publishes, %.2f allocations/frame)\n",
+         dispatch.ns_per_op, published, dispatch.allocations_per_op);
+  (void) sink;
+  const Result *results[] = {&encode, &checksum, &scale, &parse, &dispatch};
+  for (const Result *result : results) {
+    if (result->allocations_per_op != 0) {
+      return 1;
+    }
+  }
+  return published == rounds ? 0 : 1;
+}
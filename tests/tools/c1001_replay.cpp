@@ -0,0 +1,216 @@
+// Replays a wire capture through the frame parser and the register map, and reports the
+// frame rate, decode errors and the distribution of each metric's values.
+//
+//   c1001_replay device.log      (or pipe the log in on stdin)
+//
+// The input is the log of a dump_capture() call: "capture XXXX: <hex>" lines, anything
+// else on the line (timestamps, tags, colour codes) is ignored. Concatenated in offset
+// order the hex is the C1001CaptureRing record stream: a direction/length byte (bit 7 set
+// for TX), a little-endian uint32 millis() timestamp, then the bytes. With several dumps
+// in one log the last one is replayed.
+
+#include "c1001.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::c1001;
+
+struct MetricValues {
+  uint32_t pushed{0};
+  uint32_t replies{0};
+  uint32_t requests{0};
+  uint32_t too_short{0};
+  std::vector<float> values;
+};
+
+static int hex_digit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  c = (char) toupper((unsigned char) c);
+  return c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+}
+
+// Append the hex of one "capture XXXX: <hex>" line; false if the line isn't one
+static bool parse_capture_line(const std::string &line, uint32_t &offset, std::vector<uint8_t> &bytes) {
+  size_t at = line.find("capture ");
+  if (at == std::string::npos) {
+    return false;
+  }
+  size_t pos = at + 8;
+  offset = 0;
+  uint8_t digits = 0;
+  for (; pos < line.size() && hex_digit(line[pos]) >= 0; pos++, digits++) {
+    offset = offset << 4 | hex_digit(line[pos]);
+  }
+  if (digits == 0 || line.compare(pos, 2, ": ") != 0) {
+    return false;
+  }
+  for (pos += 2; pos + 1 < line.size(); pos += 2) {
+    int high = hex_digit(line[pos]);
+    int low = hex_digit(line[pos + 1]);
+    if (high < 0 || low < 0) {
+      break;
+    }
+    bytes.push_back((uint8_t) (high << 4 | low));
+  }
+  return true;
+}
+
+// The register map row for a reply (query bit set) or push report (query bit clear)
+static int find_metric(uint8_t con, uint8_t cmd) {
+  for (uint8_t metric = 0; metric < C1001_METRIC_COUNT; metric++) {
+    const C1001Frame &request = C1001Component::METRICS[metric].request;
+    if (request.con() == con && (request.cmd() & 0x7F) == (cmd & 0x7F)) {
+      return metric;
+    }
+  }
+  return -1;
+}
+
+// The value the component would derive from the payload; rows with their own handler
+// (presence, the sleep composite) report their first byte
+static float metric_value(uint8_t metric, C1001FrameView payload) {
+  const C1001MetricDef &def = C1001Component::METRICS[metric];
+  if (metric == METRIC_RESPIRATION) {
+    return C1001_DEFAULT_RESPIRATION.bpm[payload[0]];
+  }
+  if (metric == METRIC_HEART_RATE) {
+    return C1001_DEFAULT_HEART_RATE.bpm[payload[0]];
+  }
+  return def.decode != nullptr ? def.decode(payload) : payload[0];
+}
+
+int main(int argc, char **argv) {
+  std::ifstream file;
+  if (argc > 1) {
+    file.open(argv[1]);
+    if (!file) {
+      fprintf(stderr, "Can't open %s\n", argv[1]);
+      return 2;
+    }
+  }
+  std::istream &in = argc > 1 ? file : std::cin;
+  
+  // Collect the last dump's bytes, checking the offsets run on without gaps
+  std::vector<uint8_t> capture;
+  uint32_t dumps = 0;
+  uint32_t gaps = 0;
+  std::string line;
+  while (std::getline(in, line)) {
+    uint32_t offset;
+    std::vector<uint8_t> bytes;
+    if (!parse_capture_line(line, offset, bytes)) {
+      continue;
+    }
+    if (offset == 0) {
+      capture.clear();
+      dumps++;
+    } else if (offset != capture.size()) {
+      gaps++;
+    }
+    capture.insert(capture.end(), bytes.begin(), bytes.end());
+  }
+  if (capture.empty()) {
+    fprintf(stderr, "No capture lines found\n");
+    return 1;
+  }
+  
+  C1001FrameParser parser;
+  std::map<uint8_t, MetricValues> metrics;
+  uint32_t records = 0;
+  uint32_t rx_bytes = 0;
+  uint32_t tx_bytes = 0;
+  uint32_t unknown_frames = 0;
+  uint32_t first_ms = 0;
+  uint32_t last_ms = 0;
+  size_t pos = 0;
+  while (pos + C1001CaptureRing::HEADER_SIZE <= capture.size()) {
+    bool tx = (capture[pos] & 0x80) != 0;
+    uint8_t len = capture[pos] & C1001CaptureRing::MAX_CHUNK;
+    uint32_t ms = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+      ms |= (uint32_t) capture[pos + 1 + i] << (8 * i);
+    }
+    pos += C1001CaptureRing::HEADER_SIZE;
+    if (pos + len > capture.size()) {
+      break;
+    }
+    if (records++ == 0) {
+      first_ms = ms;
+    }
+    last_ms = ms;
+    
+    const uint8_t *data = &capture[pos];
+    pos += len;
+    if (tx) {
+      tx_bytes += len;
+      // Requests are whole 10-byte frames in a record of their own
+      int metric = len >= 4 ? find_metric(data[2], data[3]) : -1;
+      if (metric >= 0) {
+        metrics[metric].requests++;
+      }
+      continue;
+    }
+    
+    rx_bytes += len;
+    for (uint8_t i = 0; i < len; i++) {
+      parser.feed(data[i]);
+      while (parser.next()) {
+        int metric = find_metric(parser.con(), parser.cmd());
+        if (metric < 0) {
+          unknown_frames++;
+          continue;
+        }
+        MetricValues &values = metrics[metric];
+        C1001FrameView payload = parser.payload();
+        if (payload.size() < C1001Component::METRICS[metric].width) {
+          values.too_short++;
+          continue;
+        }
+        if ((parser.cmd() & 0x80) != 0) {
+          values.replies++;
+        } else {
+          values.pushed++;
+        }
+        values.values.push_back(metric_value(metric, payload));
+      }
+    }
+  }
+  
+  float seconds = (last_ms - first_ms) / 1000.0f;
+  printf("Capture: %zu bytes in %u records, %u dump(s) in the log, %u offset gap(s)%s\n", capture.size(), records,
+         dumps, gaps, pos == capture.size() ? "" : ", last record cut short");
+  printf("Span: %.1f s, %u bytes received, %u sent\n", seconds, rx_bytes, tx_bytes);
+  printf("Frames: %u, %.2f frames/s, %u for registers outside the register map\n", parser.frames(),
+         seconds > 0 ? parser.frames() / seconds : 0.0f, unknown_frames);
+  printf("Decode errors: %u checksum, %u resyncs, %u partial frames\n", parser.checksum_errors(),
+         parser.rejected(), parser.partial_frames());
+  printf("%-22s %8s %7s %7s %6s %8s %8s %8s %8s\n", "metric", "requests", "replies", "pushed", "short", "min",
+         "median", "mean", "max");
+  for (auto &entry : metrics) {
+    MetricValues &values = entry.second;
+    printf("%-22s %8u %7u %7u %6u", C1001Component::METRICS[entry.first].name, values.requests, values.replies,
+           values.pushed, values.too_short);
+    if (values.values.empty()) {
+      printf("\n");
+      continue;
+    }
+    std::sort(values.values.begin(), values.values.end());
+    double sum = 0;
+    for (float value : values.values) {
+      sum += value;
+    }
+    printf(" %8.1f %8.1f %8.1f %8.1f\n", values.values.front(), values.values[values.values.size() / 2],
+           sum / values.values.size(), values.values.back());
+  }
+  return 0;
+}